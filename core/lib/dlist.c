@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ * Doubly linked list manipulation routines.
+ *
+ */
+
+/**
+ * \addtogroup dlist
+ * @{
+ */
+
+#include "lib/dlist.h"
+
+#define NULL 0
+
+struct dlist_item {
+  struct dlist_item *next;
+  struct dlist_item *prev;
+};
+
+/*---------------------------------------------------------------------------*/
+/**
+ * Initialize a list.
+ *
+ * \param list The list to be initialized.
+ */
+void
+dlist_init(dlist_t list)
+{
+  list->head = list->tail = NULL;
+  list->length = 0;
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * Get a pointer to the first element of a list.
+ */
+void *
+dlist_head(dlist_t list)
+{
+  return list->head;
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * Get a pointer to the last element of a list.
+ */
+void *
+dlist_tail(dlist_t list)
+{
+  return list->tail;
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * Add an item after previtem, or at the start of the list if previtem
+ * is NULL.
+ *
+ * \param list The list.
+ * \param previtem The item after which the new item is added, it has
+ *                 to be on the list.
+ * \param newitem The item to add, it must not be on the list.
+ */
+void
+dlist_insert(dlist_t list, void *previtem, void *newitem)
+{
+  struct dlist_item *p = previtem;
+  struct dlist_item *n = newitem;
+
+  n->prev = p;
+  if(p == NULL) {
+    n->next = list->head;
+    list->head = n;
+  } else {
+    n->next = p->next;
+    p->next = n;
+  }
+
+  if(n->next == NULL) {
+    list->tail = n;
+  } else {
+    n->next->prev = n;
+  }
+  list->length++;
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * Add an item at the end of a list.
+ */
+void
+dlist_add(dlist_t list, void *item)
+{
+  dlist_insert(list, list->tail, item);
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * Add an item to the start of the list.
+ */
+void
+dlist_push(dlist_t list, void *item)
+{
+  dlist_insert(list, NULL, item);
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * Remove a specific element from a list.
+ *
+ * \param list The list.
+ * \param item The item to remove, it has to be on the list.
+ */
+void
+dlist_remove(dlist_t list, void *item)
+{
+  struct dlist_item *i = item;
+
+  if(i->prev == NULL) {
+    list->head = i->next;
+  } else {
+    i->prev->next = i->next;
+  }
+  if(i->next == NULL) {
+    list->tail = i->prev;
+  } else {
+    i->next->prev = i->prev;
+  }
+  i->next = i->prev = NULL;
+  list->length--;
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * Remove the first object on a list.
+ *
+ * \return The removed object, or NULL if the list was empty.
+ */
+void *
+dlist_pop(dlist_t list)
+{
+  void *i = list->head;
+
+  if(i != NULL) {
+    dlist_remove(list, i);
+  }
+  return i;
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * Remove the last object on a list.
+ *
+ * \return The removed object, or NULL if the list was empty.
+ */
+void *
+dlist_chop(dlist_t list)
+{
+  void *i = list->tail;
+
+  if(i != NULL) {
+    dlist_remove(list, i);
+  }
+  return i;
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * Get the length of a list.
+ */
+int
+dlist_length(dlist_t list)
+{
+  return list->length;
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * Get the next item following this item.
+ */
+void *
+dlist_item_next(void *item)
+{
+  return item == NULL ? NULL : ((struct dlist_item *)item)->next;
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * Get the item before this item.
+ */
+void *
+dlist_item_prev(void *item)
+{
+  return item == NULL ? NULL : ((struct dlist_item *)item)->prev;
+}
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ * Doubly linked list manipulation routines.
+ *
+ */
+
+/** \addtogroup lib
+    @{ */
+/**
+ * \defgroup dlist Doubly linked list library
+ *
+ * The doubly linked list library is a variant of the \ref list
+ * "linked list library" for queues. A doubly linked list knows its
+ * last element and every element knows the one before it, so that
+ * elements are added and removed at either end, or removed from the
+ * middle, in constant time.
+ *
+ * An element \b must be a structure whose first two elements are
+ * pointers: the next and the previous element. As the next pointer
+ * comes first, the elements of a doubly linked list can be walked
+ * with list_item_next() by code that only knows singly linked lists.
+ *
+ * Lists are declared with the DLIST() macro, or inside a structure
+ * with DLIST_STRUCT() and DLIST_STRUCT_INIT().
+ *
+ * Unlike list_add() and list_push(), dlist_add() and dlist_push() do
+ * not look for the element in the list first: an element must not be
+ * added to a list it is already on, and dlist_remove() must only be
+ * called for an element that is on the list.
+ *
+ * @{
+ */
+
+#ifndef DLIST_H_
+#define DLIST_H_
+
+#define DLIST_CONCAT2(s1, s2) s1##s2
+#define DLIST_CONCAT(s1, s2) DLIST_CONCAT2(s1, s2)
+
+/**
+ * Declare a doubly linked list.
+ *
+ * The list variable is declared as static to make it easy to use in a
+ * single C module without unnecessarily exporting the name to other
+ * modules.
+ *
+ * \param name The name of the list.
+ */
+#define DLIST(name) \
+         static struct dlist DLIST_CONCAT(name,_dlist) = { NULL, NULL, 0 }; \
+         static dlist_t name = &DLIST_CONCAT(name,_dlist)
+
+/**
+ * Declare a doubly linked list inside a structure declaraction.
+ *
+ * The list must be initialized with DLIST_STRUCT_INIT() before it is
+ * used.
+ *
+ * \param name The name of the list.
+ */
+#define DLIST_STRUCT(name) \
+         struct dlist DLIST_CONCAT(name,_dlist); \
+         dlist_t name
+
+/**
+ * Initialize a doubly linked list that is part of a structure.
+ *
+ * \param struct_ptr A pointer to the struct
+ * \param name The name of the list.
+ */
+#define DLIST_STRUCT_INIT(struct_ptr, name)                             \
+    do {                                                                \
+       (struct_ptr)->name = &((struct_ptr)->DLIST_CONCAT(name,_dlist)); \
+       dlist_init((struct_ptr)->name);                                  \
+    } while(0)
+
+struct dlist {
+  void *head;
+  void *tail;
+  unsigned short length;
+};
+
+/**
+ * The doubly linked list type.
+ *
+ */
+typedef struct dlist * dlist_t;
+
+void   dlist_init(dlist_t list);
+void * dlist_head(dlist_t list);
+void * dlist_tail(dlist_t list);
+void * dlist_pop(dlist_t list);
+void   dlist_push(dlist_t list, void *item);
+
+void * dlist_chop(dlist_t list);
+
+void   dlist_add(dlist_t list, void *item);
+void   dlist_remove(dlist_t list, void *item);
+
+int    dlist_length(dlist_t list);
+
+void   dlist_insert(dlist_t list, void *previtem, void *newitem);
+
+void * dlist_item_next(void *item);
+void * dlist_item_prev(void *item);
+
+#endif /* DLIST_H_ */
+
+/** @} */
+/** @} */
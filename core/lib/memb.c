@@ -53,51 +53,60 @@ memb_init(struct memb *m)
 {
   memset(m->count, 0, m->num);
   memset(m->mem, 0, m->size * m->num);
+  memset(m->link, 0, m->num * sizeof(unsigned short));
+  m->free = 0;
+  m->numfree = m->num;
 }
 /*---------------------------------------------------------------------------*/
 void *
 memb_alloc(struct memb *m)
 {
-  int i;
+  unsigned short i;
 
-  for(i = 0; i < m->num; ++i) {
-    if(m->count[i] == 0) {
-      /* If this block was unused, we increase the reference count to
-	 indicate that it now is used and return a pointer to the
-	 memory block. */
-      ++(m->count[i]);
-      return (void *)((char *)m->mem + (i * m->size));
-    }
+  /* No free block, so we return NULL to indicate failure to allocate
+     block. */
+  if(m->free >= m->num) {
+    return NULL;
   }
 
-  /* No free block was found, so we return NULL to indicate failure to
-     allocate block. */
-  return NULL;
+  /* Pop the first free block, increase its reference count to
+     indicate that it now is used and return a pointer to it. */
+  i = m->free;
+  m->free = i + 1 + m->link[i];
+  ++(m->count[i]);
+  --(m->numfree);
+  return (void *)((char *)m->mem + (i * m->size));
 }
 /*---------------------------------------------------------------------------*/
 char
 memb_free(struct memb *m, void *ptr)
 {
-  int i;
-  char *ptr2;
+  unsigned short i;
+  unsigned short offset;
+
+  if(!memb_inmemb(m, ptr)) {
+    return -1;
+  }
+
+  /* Find the block to which "ptr" points to, it has to point to the
+     start of the block. */
+  offset = (char *)ptr - (char *)m->mem;
+  i = offset / m->size;
+  if(i * m->size != offset) {
+    return -1;
+  }
 
-  /* Walk through the list of blocks and try to find the block to
-     which the pointer "ptr" points to. */
-  ptr2 = (char *)m->mem;
-  for(i = 0; i < m->num; ++i) {
-    
-    if(ptr2 == (char *)ptr) {
-      /* We've found to block to which "ptr" points so we decrease the
-	 reference count and return the new value of it. */
-      if(m->count[i] > 0) {
-	/* Make sure that we don't deallocate free memory. */
-	--(m->count[i]);
-      }
-      return m->count[i];
+  /* Make sure that we don't deallocate free memory. */
+  if(m->count[i] > 0) {
+    --(m->count[i]);
+    if(m->count[i] == 0) {
+      /* Push the block on the free stack */
+      m->link[i] = m->free - i - 1;
+      m->free = i;
+      ++(m->numfree);
     }
-    ptr2 += m->size;
   }
-  return -1;
+  return m->count[i];
 }
 /*---------------------------------------------------------------------------*/
 int
@@ -110,15 +119,6 @@ memb_inmemb(struct memb *m, void *ptr)
 int
 memb_numfree(struct memb *m)
 {
-  int i;
-  int num_free = 0;
-
-  for(i = 0; i < m->num; ++i) {
-    if(m->count[i] == 0) {
-      ++num_free;
-    }
-  }
-
-  return num_free;
+  return m->numfree;
 }
 /** @} */
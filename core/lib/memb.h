@@ -88,16 +88,30 @@ MEMB(connections, struct connection, 16);
  */
 #define MEMB(name, structure, num) \
         static char CC_CONCAT(name,_memb_count)[num]; \
+        static unsigned short CC_CONCAT(name,_memb_link)[num]; \
         static structure CC_CONCAT(name,_memb_mem)[num]; \
         static struct memb name = {sizeof(structure), num, \
                                           CC_CONCAT(name,_memb_count), \
-                                          (void *)CC_CONCAT(name,_memb_mem)}
+                                          (void *)CC_CONCAT(name,_memb_mem), \
+                                          CC_CONCAT(name,_memb_link), \
+                                          0, num}
 
+/*
+ * The free blocks form a stack kept in link[], next to count[], so
+ * that memb_alloc() and memb_free() do not search and never touch the
+ * contents of a block. link[i] of a free block holds the distance to
+ * the next free block minus one: a zeroed link[] is a list of every
+ * block in order, which keeps a MEMB() usable before memb_init() is
+ * called.
+ */
 struct memb {
   unsigned short size;
   unsigned short num;
   char *count;
   void *mem;
+  unsigned short *link;
+  unsigned short free;   /* first free block, num if none */
+  unsigned short numfree;
 };
 
 /**
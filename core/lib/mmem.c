@@ -58,7 +58,35 @@
 LIST(mmemlist);
 unsigned int avail_memory;
 static char memory[MMEM_SIZE];
+static struct mmem_stats stats;
 
+/*---------------------------------------------------------------------------*/
+/*
+ * Move blocks down over the holes left by mmem_free(), in address
+ * order, until max_bytes have been moved. Blocks that are already in
+ * place are skipped, so a compaction that was cut short is resumed by
+ * the next call. Returns non-zero once no hole is left.
+ */
+static int
+compact(unsigned int max_bytes)
+{
+  struct mmem *n;
+  char *end = memory;
+
+  for(n = list_head(mmemlist); n != NULL; n = n->next) {
+    if((char *)n->ptr != end) {
+      if(n->size > max_bytes) {
+        return 0;
+      }
+      memmove(end, n->ptr, n->size);
+      n->ptr = end;
+      max_bytes -= n->size;
+      stats.moved += n->size;
+    }
+    end += n->size;
+  }
+  return 1;
+}
 /*---------------------------------------------------------------------------*/
 /**
  * \brief      Allocate a managed memory block
@@ -72,6 +100,11 @@ static char memory[MMEM_SIZE];
  *             memory allocated with this function must be deallocated
  *             using the mmem_free() function.
  *
+ *             The block goes in the first hole that is large enough,
+ *             or at the top of the memory. When the free memory is
+ *             only available as holes, the memory is compacted first
+ *             and other blocks may move.
+ *
  *             \note This function does NOT return a pointer to the
  *             allocated memory, but a pointer to a structure that
  *             contains information about the managed memory. The
@@ -82,18 +115,36 @@ static char memory[MMEM_SIZE];
 int
 mmem_alloc(struct mmem *m, unsigned int size)
 {
+  struct mmem *n;
+  struct mmem *prev = NULL;
+  char *end = memory;
+
   /* Check if we have enough memory left for this allocation. */
   if(avail_memory < size) {
+    stats.failed++;
     return 0;
   }
 
-  /* We had enough memory so we add this memory block to the end of
-     the list of allocated memory blocks. */
-  list_add(mmemlist, m);
+  /* Look for a hole between two blocks, the list is sorted by
+     address. */
+  for(n = list_head(mmemlist); n != NULL; prev = n, n = n->next) {
+    if((unsigned int)((char *)n->ptr - end) >= size) {
+      break;
+    }
+    end = (char *)n->ptr + n->size;
+  }
 
-  /* Set up the pointer so that it points to the first available byte
-     in the memory block. */
-  m->ptr = &memory[MMEM_SIZE - avail_memory];
+  /* Not enough room above the last block either: the free memory is
+     spread over holes, close them. */
+  if(n == NULL && (unsigned int)(&memory[MMEM_SIZE] - end) < size) {
+    compact(MMEM_SIZE);
+    stats.compactions++;
+    end = &memory[MMEM_SIZE - avail_memory];
+  }
+
+  list_insert(mmemlist, prev, m);
+
+  m->ptr = end;
 
   /* Remember the size of this memory block. */
   m->size = size;
@@ -101,6 +152,11 @@ mmem_alloc(struct mmem *m, unsigned int size)
   /* Decrease the amount of available memory. */
   avail_memory -= size;
 
+  stats.allocs++;
+  if(MMEM_SIZE - avail_memory > stats.max_used) {
+    stats.max_used = MMEM_SIZE - avail_memory;
+  }
+
   /* Return non-zero to indicate that we were able to allocate
      memory. */
   return 1;
@@ -114,29 +170,43 @@ mmem_alloc(struct mmem *m, unsigned int size)
  *             This function deallocates a managed memory block that
  *             previously has been allocated with mmem_alloc().
  *
+ *             No memory is moved, the block leaves a hole that is
+ *             reused by mmem_alloc() or closed by mmem_compact().
+ *
  */
 void
 mmem_free(struct mmem *m)
 {
-  struct mmem *n;
-
-  if(m->next != NULL) {
-    /* Compact the memory after the allocation that is to be removed
-       by moving it downwards. */
-    memmove(m->ptr, m->next->ptr,
-	    &memory[MMEM_SIZE - avail_memory] - (char *)m->next->ptr);
-    
-    /* Update all the memory pointers that points to memory that is
-       after the allocation that is to be removed. */
-    for(n = m->next; n != NULL; n = n->next) {
-      n->ptr = (void *)((char *)n->ptr - m->size);
-    }
-  }
-
   avail_memory += m->size;
 
   /* Remove the memory block from the list. */
   list_remove(mmemlist, m);
+
+  stats.frees++;
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief      Compact the managed memory incrementally
+ * \param max_bytes The largest number of bytes to move
+ * \return     Non-zero if no hole is left
+ *
+ *             Moves blocks over the holes left by mmem_free(), but
+ *             not more than max_bytes of memory, so that it can be
+ *             called regularly from a process with a bounded cost.
+ *
+ */
+int
+mmem_compact(unsigned int max_bytes)
+{
+  stats.compactions++;
+  return compact(max_bytes);
+}
+/*---------------------------------------------------------------------------*/
+const struct mmem_stats *
+mmem_get_stats(void)
+{
+  stats.used = MMEM_SIZE - avail_memory;
+  return &stats;
 }
 /*---------------------------------------------------------------------------*/
 /**
@@ -38,11 +38,14 @@
  * \defgroup mmem Managed memory allocator
  *
  * The managed memory allocator is a fragmentation-free memory
- * manager. It keeps the allocated memory free from fragmentation by
- * compacting the memory when blocks are freed. A program that uses
- * the managed memory module cannot be sure that allocated memory
- * stays in place. Therefore, a level of indirection is used: access
- * to allocated memory must always be done using a special macro.
+ * manager. Freed blocks leave holes that are reused by later
+ * allocations, and the memory is compacted when an allocation only
+ * fits once the holes are closed, or step by step with
+ * mmem_compact(). A program that uses the managed memory module
+ * cannot be sure that allocated memory stays in place across
+ * mmem_alloc() and mmem_compact(). Therefore, a level of indirection
+ * is used: access to allocated memory must always be done using a
+ * special macro. mmem_free() never moves memory.
  *
  * \note This module has not been heavily tested.
  * @{
@@ -83,8 +86,20 @@ struct mmem {
 /* XXX: tagga minne med "interrupt usage", vilke gr att man r
    speciellt varsam under free(). */
 
+struct mmem_stats {
+  unsigned int used;
+  unsigned int max_used;
+  unsigned int allocs;
+  unsigned int frees;
+  unsigned int failed;
+  unsigned int compactions;
+  unsigned long moved;   /* bytes moved by compactions */
+};
+
 int  mmem_alloc(struct mmem *m, unsigned int size);
 void mmem_free(struct mmem *);
+int  mmem_compact(unsigned int max_bytes);
+const struct mmem_stats *mmem_get_stats(void);
 void mmem_init(void);
 
 #endif /* MMEM_H_ */
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Bulk ring buffer library implementation
+ */
+
+#include "lib/ringbuf16.h"
+#include <sys/cc.h>
+#include <string.h>
+
+/*
+ * The data must be in the buffer before the index that hands it over
+ * is written, and read before the index that frees it. CC_ACCESS_NOW
+ * orders the index accesses, the barrier keeps memcpy() on its side.
+ */
+#ifdef __GNUC__
+#define BARRIER() __asm__ __volatile__("" : : : "memory")
+#else
+#define BARRIER()
+#endif
+
+#define PUT_PTR(r) CC_ACCESS_NOW(uint16_t, (r)->put_ptr)
+#define GET_PTR(r) CC_ACCESS_NOW(uint16_t, (r)->get_ptr)
+/*---------------------------------------------------------------------------*/
+void
+ringbuf16_init(struct ringbuf16 *r, uint8_t *dataptr, uint16_t size)
+{
+  r->data = dataptr;
+  r->mask = size - 1;
+  r->put_ptr = 0;
+  r->get_ptr = 0;
+}
+/*---------------------------------------------------------------------------*/
+uint16_t
+ringbuf16_peek_put(struct ringbuf16 *r, uint8_t **ptr)
+{
+  uint16_t put = r->put_ptr;
+  uint16_t space = r->mask + 1 - (uint16_t)(put - GET_PTR(r));
+  uint16_t contiguous = r->mask + 1 - (put & r->mask);
+
+  BARRIER();
+  *ptr = &r->data[put & r->mask];
+  return space < contiguous ? space : contiguous;
+}
+/*---------------------------------------------------------------------------*/
+void
+ringbuf16_commit_put(struct ringbuf16 *r, uint16_t len)
+{
+  BARRIER();
+  PUT_PTR(r) = r->put_ptr + len;
+}
+/*---------------------------------------------------------------------------*/
+uint16_t
+ringbuf16_peek_get(struct ringbuf16 *r, uint8_t **ptr)
+{
+  uint16_t get = r->get_ptr;
+  uint16_t elements = (uint16_t)(PUT_PTR(r) - get);
+  uint16_t contiguous = r->mask + 1 - (get & r->mask);
+
+  BARRIER();
+  *ptr = &r->data[get & r->mask];
+  return elements < contiguous ? elements : contiguous;
+}
+/*---------------------------------------------------------------------------*/
+void
+ringbuf16_commit_get(struct ringbuf16 *r, uint16_t len)
+{
+  BARRIER();
+  GET_PTR(r) = r->get_ptr + len;
+}
+/*---------------------------------------------------------------------------*/
+int
+ringbuf16_put(struct ringbuf16 *r, uint8_t c)
+{
+  uint8_t *p;
+
+  if(ringbuf16_peek_put(r, &p) == 0) {
+    return 0;
+  }
+  *p = c;
+  ringbuf16_commit_put(r, 1);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+int
+ringbuf16_get(struct ringbuf16 *r)
+{
+  uint8_t *p;
+  uint8_t c;
+
+  if(ringbuf16_peek_get(r, &p) == 0) {
+    return -1;
+  }
+  c = *p;
+  ringbuf16_commit_get(r, 1);
+  return c;
+}
+/*---------------------------------------------------------------------------*/
+uint16_t
+ringbuf16_write(struct ringbuf16 *r, const void *src, uint16_t len)
+{
+  const uint8_t *s = src;
+  uint16_t done = 0;
+  uint16_t n;
+  uint8_t *p;
+
+  /* At most two copies, before and after the end of the array */
+  while(done < len && (n = ringbuf16_peek_put(r, &p)) > 0) {
+    if(n > len - done) {
+      n = len - done;
+    }
+    memcpy(p, s + done, n);
+    ringbuf16_commit_put(r, n);
+    done += n;
+  }
+  return done;
+}
+/*---------------------------------------------------------------------------*/
+uint16_t
+ringbuf16_read(struct ringbuf16 *r, void *dst, uint16_t len)
+{
+  uint8_t *d = dst;
+  uint16_t done = 0;
+  uint16_t n;
+  uint8_t *p;
+
+  while(done < len && (n = ringbuf16_peek_get(r, &p)) > 0) {
+    if(n > len - done) {
+      n = len - done;
+    }
+    memcpy(d + done, p, n);
+    ringbuf16_commit_get(r, n);
+    done += n;
+  }
+  return done;
+}
+/*---------------------------------------------------------------------------*/
+uint16_t
+ringbuf16_size(struct ringbuf16 *r)
+{
+  return r->mask + 1;
+}
+/*---------------------------------------------------------------------------*/
+uint16_t
+ringbuf16_elements(struct ringbuf16 *r)
+{
+  return (uint16_t)(PUT_PTR(r) - GET_PTR(r));
+}
+/*---------------------------------------------------------------------------*/
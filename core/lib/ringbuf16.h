@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Header file for the bulk ring buffer library
+ */
+
+/** \addtogroup lib
+ * @{ */
+
+/**
+ * \defgroup ringbuf16 Bulk ring buffer library
+ * @{
+ *
+ * A single-producer, single-consumer ring buffer of bytes with 16-bit
+ * indices, for buffers larger than the 128 bytes of \ref ringbuf
+ * "ringbuf" and for data that is written or read in blocks.
+ *
+ * One side only writes (ringbuf16_put(), ringbuf16_write(),
+ * ringbuf16_peek_put() and ringbuf16_commit_put()), the other side
+ * only reads, and either side may run in an interrupt handler.
+ * The peek functions return the contiguous part of the buffer that
+ * can be written or read in place; the matching commit function then
+ * hands the bytes over to the other side.
+ */
+
+#ifndef RINGBUF16_H_
+#define RINGBUF16_H_
+
+#include "contiki-conf.h"
+
+/**
+ * \brief      Structure that holds the state of a bulk ring buffer.
+ *
+ *             The indices run freely and are masked on access, so
+ *             that the whole buffer can be filled. Each index is
+ *             written by one side only, and 16-bit accesses must be
+ *             atomic on the platform.
+ */
+struct ringbuf16 {
+  uint8_t *data;
+  uint16_t mask;
+  uint16_t put_ptr, get_ptr;
+};
+
+/**
+ * \brief      Initialize a bulk ring buffer
+ * \param r    A pointer to a struct ringbuf16
+ * \param a    A pointer to an array to hold the data in the buffer
+ * \param size_power_of_two The size of the array, a power of two
+ *             of at most 32768 bytes
+ */
+void     ringbuf16_init(struct ringbuf16 *r, uint8_t *a,
+                        uint16_t size_power_of_two);
+
+/**
+ * \brief      Insert a byte into the ring buffer
+ * \return     Non-zero if the byte was written, zero if the buffer was full
+ */
+int      ringbuf16_put(struct ringbuf16 *r, uint8_t c);
+
+/**
+ * \brief      Get a byte from the ring buffer
+ * \return     The byte, or -1 if the buffer was empty
+ */
+int      ringbuf16_get(struct ringbuf16 *r);
+
+/**
+ * \brief      Copy up to len bytes into the ring buffer
+ * \return     The number of bytes written, less than len if the
+ *             buffer got full
+ */
+uint16_t ringbuf16_write(struct ringbuf16 *r, const void *src, uint16_t len);
+
+/**
+ * \brief      Copy up to len bytes out of the ring buffer
+ * \return     The number of bytes read
+ */
+uint16_t ringbuf16_read(struct ringbuf16 *r, void *dst, uint16_t len);
+
+/**
+ * \brief      Get the free contiguous space at the write position
+ * \param ptr  Set to where the bytes are to be written
+ * \return     The number of bytes that can be written at *ptr
+ */
+uint16_t ringbuf16_peek_put(struct ringbuf16 *r, uint8_t **ptr);
+
+/**
+ * \brief      Hand over len bytes written after ringbuf16_peek_put()
+ */
+void     ringbuf16_commit_put(struct ringbuf16 *r, uint16_t len);
+
+/**
+ * \brief      Get the contiguous data at the read position
+ * \param ptr  Set to where the bytes are to be read
+ * \return     The number of bytes that can be read at *ptr
+ */
+uint16_t ringbuf16_peek_get(struct ringbuf16 *r, uint8_t **ptr);
+
+/**
+ * \brief      Free len bytes read after ringbuf16_peek_get()
+ */
+void     ringbuf16_commit_get(struct ringbuf16 *r, uint16_t len);
+
+/**
+ * \brief      Get the size of a ring buffer
+ */
+uint16_t ringbuf16_size(struct ringbuf16 *r);
+
+/**
+ * \brief      Get the number of bytes currently in the ring buffer
+ */
+uint16_t ringbuf16_elements(struct ringbuf16 *r);
+
+#endif /* RINGBUF16_H_ */
+
+/** @}*/
+/** @}*/
@@ -36,6 +36,9 @@
  * \author
  *         Nitin Shivaraman <nitin.shivaraman@tum-create.edu.sg>
  */
+#ifndef C_SYNC_H_
+#define C_SYNC_H_
+
 #include "contiki-conf.h"
 
 #include "net/rime/rime.h"
@@ -107,6 +110,7 @@ typedef struct neighbour {
   uint32_t  last_hw_my_fine;
   int32_t   coarse_diff;
   int32_t   fine_diff;
+  uint16_t  last_heard;            /// << clock_seconds() of the last frame
 } neighbour_t;
 
 typedef struct cluster {
@@ -162,6 +166,8 @@ uint8_t csync_CHB_placing(void);
 void csync_trusted_synchronization(neighbour_t *n, uint16_t c_addr, double cons_rate);
 uint8_t csync_all_synced(void);
 uint8_t check_mod_neighbours(uint16_t n_id);
+list_t csync_neighbour_list(void);
+void csync_neighbour_remove(neighbour_t *n);
 
 uint8_t handle_lists(struct announcement *a, struct announcement_value *a_value, struct neighbour *n);
 void init_consensus_convergence(void);
@@ -172,6 +178,8 @@ void update_neighbour_role(uint16_t addr, role_t role_sender);
 
 PROCESS_NAME(c_gtsp_process);
 
+void csync_wake(struct process *p);
+
 struct announcement discovery_announcement;
 struct announcement revelation_announcement;
 struct announcement declaration_announcement;
@@ -195,6 +203,7 @@ void gtsp_update_rtimer(list_t neighbour_list);
 inline char enter_election_revelation(rtimer_t *rt);
 inline char enter_election_declaration(rtimer_t *rt);
 inline char enter_connection_revelation(rtimer_t *rt);
+char enter_connection_late(rtimer_t *rt);
 inline char enter_connection_declaration(rtimer_t *rt);
 inline char enter_convergence(rtimer_t *rt);
 inline char enter_consensus_revelation(rtimer_t *rt);
@@ -203,3 +212,4 @@ inline char enter_byzantine_consensus(rtimer_t *rt);
 inline char enter_idle(rtimer_t *rt);
 inline char enter_discovery(rtimer_t *rt);
 
+#endif /* C_SYNC_H_ */
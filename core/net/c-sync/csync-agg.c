@@ -0,0 +1,535 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+
+/**
+ * \file
+ *         In-network aggregation over the C-sync cluster hierarchy
+ */
+
+#include "net/c-sync/c-sync.h"
+#include "net/c-sync/csync-agg.h"
+#include "net/rime/rime.h"
+#include "lib/random.h"
+#include "sys/ctimer.h"
+#if CSYNC_TDMA
+#include "net/c-sync/csync-tdma.h"
+#endif /*CSYNC_TDMA*/
+
+#include <string.h>
+
+#define DEBUG 0
+#if DEBUG
+#include <stdio.h>
+#define PRINTF(...) printf(__VA_ARGS__)
+#else
+#define PRINTF(...)
+#endif
+
+#define HOPS_UNKNOWN 0xff
+#define BEACON_JITTER (CLOCK_SECOND / 32)
+
+struct agg_msg {
+  uint8_t round;
+  uint8_t hops;
+  uint16_t count;
+  uint8_t value[CSYNC_AGG_VALUE_MAX];
+};
+#define AGG_MSG_HEADERLEN 4
+
+static const struct csync_agg_operator *op;
+static csync_agg_sample_t sample_func;
+static csync_agg_callback_t sink_callback;
+
+static struct broadcast_conn beacon_conn;
+static struct unicast_conn data_conn;
+static struct ctimer beacon_timer, member_timer, upstream_timer, result_timer;
+static struct csync_agg_stats stats;
+
+static uint8_t is_open;
+static uint8_t agg_round;
+static uint8_t hops;
+static linkaddr_t parent;
+static uint8_t sent_upstream;
+static uint8_t upstream_due;
+static uint16_t count;
+static uint8_t value[CSYNC_AGG_VALUE_MAX];
+
+static void send_upstream(void *ptr);
+
+/*---------------------------------------------------------------------------*/
+static uint8_t
+is_sink(void)
+{
+  return my_addr == CSYNC_AGG_SINK;
+}
+/*---------------------------------------------------------------------------*/
+/* Only listen to C-sync neighbours, so that the hardcoded
+   MOD_NEIGHBOURS topologies also hold for the aggregation tree. */
+static uint8_t
+is_neighbour(const linkaddr_t *from)
+{
+  struct neighbour *n;
+
+  for(n = list_head(csync_neighbour_list()); n != NULL; n = list_item_next(n))
+  {
+    if(n->addr == from->u16)
+    {
+      return 1;
+    }
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static void
+merge_value(const void *other, uint16_t other_count)
+{
+  if(count == 0)
+  {
+    memcpy(value, other, op->value_len);
+  }
+  else
+  {
+    op->merge(value, other);
+  }
+  count += other_count;
+}
+/*---------------------------------------------------------------------------*/
+static void
+send_value(const linkaddr_t *to, const void *v, uint16_t c)
+{
+  struct agg_msg *msg;
+
+  packetbuf_clear();
+  msg = packetbuf_dataptr();
+  msg->round = agg_round;
+  msg->hops = hops;
+  msg->count = c;
+  memcpy(msg->value, v, op->value_len);
+  packetbuf_set_datalen(AGG_MSG_HEADERLEN + op->value_len);
+  unicast_send(&data_conn, to);
+  stats.tx++;
+}
+/*---------------------------------------------------------------------------*/
+static void
+send_own_sample(const linkaddr_t *to)
+{
+  uint8_t own[CSYNC_AGG_VALUE_MAX];
+
+  op->init(own, sample_func());
+  send_value(to, own, 1);
+}
+/*---------------------------------------------------------------------------*/
+static void
+send_beacon(void *ptr)
+{
+  struct agg_msg *msg;
+
+  packetbuf_clear();
+  msg = packetbuf_dataptr();
+  msg->round = agg_round;
+  msg->hops = hops;
+  msg->count = 0;
+  packetbuf_set_datalen(AGG_MSG_HEADERLEN);
+  broadcast_send(&beacon_conn);
+  stats.tx++;
+}
+/*---------------------------------------------------------------------------*/
+static void
+beacon_received(struct broadcast_conn *c, const linkaddr_t *from)
+{
+  struct agg_msg msg;
+
+  if(!is_open || is_sink() || my_cluster.role == CM ||
+     packetbuf_datalen() < AGG_MSG_HEADERLEN || !is_neighbour(from))
+  {
+    return;
+  }
+  memcpy(&msg, packetbuf_dataptr(), AGG_MSG_HEADERLEN);
+  stats.rx++;
+
+  if(msg.hops >= CSYNC_AGG_MAX_DEPTH || msg.hops + 1 >= hops)
+  {
+    return;
+  }
+
+  /* Shorter path to the sink, pass it on once things settle */
+  hops = msg.hops + 1;
+  agg_round = msg.round;
+  linkaddr_copy(&parent, from);
+  stats.hops = hops;
+  stats.round = agg_round;
+  ctimer_set(&beacon_timer, 1 + random_rand() % BEACON_JITTER, send_beacon, NULL);
+  PRINTF("agg: parent %u hops %u\n", parent.u16, hops);
+
+  /* Our turn has passed without a way to the sink, send now */
+  if(upstream_due)
+  {
+    upstream_due = 0;
+    send_upstream(NULL);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+data_received(struct unicast_conn *c, const linkaddr_t *from)
+{
+  struct agg_msg msg;
+
+  if(!is_open || packetbuf_datalen() < AGG_MSG_HEADERLEN + op->value_len)
+  {
+    return;
+  }
+  memcpy(&msg, packetbuf_dataptr(), AGG_MSG_HEADERLEN + op->value_len);
+  stats.rx++;
+
+  if(is_sink())
+  {
+    merge_value(msg.value, msg.count);
+    stats.merged++;
+  }
+  else if(!CSYNC_AGG_MERGE || sent_upstream)
+  {
+    /* Baseline mode, or a straggler after our own aggregate left */
+    if(hops != HOPS_UNKNOWN)
+    {
+      send_value(&parent, msg.value, msg.count);
+    }
+  }
+  else
+  {
+    merge_value(msg.value, msg.count);
+    stats.merged++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+send_upstream(void *ptr)
+{
+  sent_upstream = 1;
+  if(hops == HOPS_UNKNOWN || is_sink())
+  {
+    return;
+  }
+#if CSYNC_AGG_MERGE
+  if(count > 0)
+  {
+    send_value(&parent, value, count);
+  }
+#else /*CSYNC_AGG_MERGE*/
+  send_own_sample(&parent);
+#endif /*CSYNC_AGG_MERGE*/
+}
+/*---------------------------------------------------------------------------*/
+static void
+wait_for_level(void *ptr)
+{
+  /* The deepest nodes go first, so that every aggregate already
+     contains the ones of its children when it leaves */
+  if(hops == HOPS_UNKNOWN)
+  {
+    upstream_due = 1;
+    return;
+  }
+  ctimer_set(&upstream_timer,
+             (CSYNC_AGG_MAX_DEPTH - hops) * CSYNC_AGG_LEVEL_INTERVAL,
+             send_upstream, NULL);
+}
+/*---------------------------------------------------------------------------*/
+static void
+send_to_head(void *ptr)
+{
+  struct CHB *ch;
+  linkaddr_t addr;
+
+  /* A CB that is not on the tree reports like a member */
+  if(my_cluster.role == CB && hops != HOPS_UNKNOWN)
+  {
+    return;
+  }
+  ch = list_head(*my_cluster.CHs_list);
+  if(ch == NULL)
+  {
+    return;
+  }
+  addr.u16 = ch->addr;
+  send_own_sample(&addr);
+  if(my_cluster.role == CB)
+  {
+    count = 0;
+    sent_upstream = 1;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static clock_time_t
+member_start(void)
+{
+#if CSYNC_TDMA
+  /* The slotted MAC holds the sample back until the slot the table of
+     the CH gives us, there is no need to spread the members out */
+  if(csync_tdma_is_active())
+  {
+    return CSYNC_AGG_MEMBER_START;
+  }
+#endif /*CSYNC_TDMA*/
+  return CSYNC_AGG_MEMBER_START +
+         (my_placing % CSYNC_AGG_MEMBER_SLOTS) * CSYNC_AGG_MEMBER_SLOT;
+}
+/*---------------------------------------------------------------------------*/
+static void
+round_complete(void *ptr)
+{
+  if(sink_callback != NULL)
+  {
+    sink_callback(op, value, count);
+  }
+  else
+  {
+    printf("\n%u AGG r %u %s n %u", my_addr, agg_round, op->name, count);
+    op->print(value, count);
+  }
+  csync_agg_print_stats();
+}
+/*---------------------------------------------------------------------------*/
+void
+csync_agg_start_round(void)
+{
+  uint8_t own[CSYNC_AGG_VALUE_MAX];
+
+  if(!is_open)
+  {
+    return;
+  }
+
+  ctimer_stop(&beacon_timer);
+  ctimer_stop(&member_timer);
+  ctimer_stop(&upstream_timer);
+  ctimer_stop(&result_timer);
+
+  count = 0;
+  sent_upstream = 0;
+  upstream_due = 0;
+  hops = HOPS_UNKNOWN;
+  stats.tx = stats.rx = stats.merged = 0;
+
+  if(is_sink())
+  {
+    hops = 0;
+    agg_round++;
+    op->init(own, sample_func());
+    merge_value(own, 1);
+    send_beacon(NULL);
+    ctimer_set(&result_timer, CSYNC_AGG_ROUND_END, round_complete, NULL);
+  }
+  else if(my_cluster.role == CM)
+  {
+    ctimer_set(&member_timer, member_start(), send_to_head, NULL);
+  }
+  else
+  {
+#if CSYNC_AGG_MERGE
+    op->init(own, sample_func());
+    merge_value(own, 1);
+#endif /*CSYNC_AGG_MERGE*/
+    if(my_cluster.role == CB)
+    {
+      ctimer_set(&member_timer, member_start(), send_to_head, NULL);
+    }
+    ctimer_set(&upstream_timer, CSYNC_AGG_UPSTREAM_START, wait_for_level, NULL);
+  }
+  stats.hops = hops;
+  stats.round = agg_round;
+}
+/*---------------------------------------------------------------------------*/
+static const struct broadcast_callbacks beacon_callbacks = {beacon_received};
+static const struct unicast_callbacks data_callbacks = {data_received};
+/*---------------------------------------------------------------------------*/
+void
+csync_agg_open(const struct csync_agg_operator *o,
+               csync_agg_sample_t sample, csync_agg_callback_t callback)
+{
+  op = o;
+  sample_func = sample;
+  sink_callback = callback;
+  broadcast_open(&beacon_conn, CSYNC_AGG_CHANNEL, &beacon_callbacks);
+  unicast_open(&data_conn, CSYNC_AGG_CHANNEL + 1, &data_callbacks);
+  is_open = 1;
+}
+/*---------------------------------------------------------------------------*/
+void
+csync_agg_close(void)
+{
+  is_open = 0;
+  ctimer_stop(&beacon_timer);
+  ctimer_stop(&member_timer);
+  ctimer_stop(&upstream_timer);
+  ctimer_stop(&result_timer);
+  broadcast_close(&beacon_conn);
+  unicast_close(&data_conn);
+}
+/*---------------------------------------------------------------------------*/
+const struct csync_agg_stats *
+csync_agg_get_stats(void)
+{
+  return &stats;
+}
+/*---------------------------------------------------------------------------*/
+void
+csync_agg_print_stats(void)
+{
+  printf("\n%u A r %u h %u tx %u rx %u m %u", my_addr, stats.round,
+         stats.hops, stats.tx, stats.rx, stats.merged);
+}
+/*---------------------------------------------------------------------------*/
+/* Operators */
+/*---------------------------------------------------------------------------*/
+static void
+scalar_init(void *value, int16_t sample)
+{
+  memcpy(value, &sample, sizeof(int16_t));
+}
+/*---------------------------------------------------------------------------*/
+static void
+min_merge(void *value, const void *other)
+{
+  int16_t a, b;
+
+  memcpy(&a, value, sizeof(int16_t));
+  memcpy(&b, other, sizeof(int16_t));
+  if(b < a)
+  {
+    memcpy(value, &b, sizeof(int16_t));
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+max_merge(void *value, const void *other)
+{
+  int16_t a, b;
+
+  memcpy(&a, value, sizeof(int16_t));
+  memcpy(&b, other, sizeof(int16_t));
+  if(b > a)
+  {
+    memcpy(value, &b, sizeof(int16_t));
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+scalar_print(const void *value, uint16_t count)
+{
+  int16_t a;
+
+  memcpy(&a, value, sizeof(int16_t));
+  printf(" v %d", a);
+}
+/*---------------------------------------------------------------------------*/
+static void
+avg_init(void *value, int16_t sample)
+{
+  int32_t sum = sample;
+
+  memcpy(value, &sum, sizeof(int32_t));
+}
+/*---------------------------------------------------------------------------*/
+static void
+avg_merge(void *value, const void *other)
+{
+  int32_t a, b;
+
+  memcpy(&a, value, sizeof(int32_t));
+  memcpy(&b, other, sizeof(int32_t));
+  a += b;
+  memcpy(value, &a, sizeof(int32_t));
+}
+/*---------------------------------------------------------------------------*/
+static void
+avg_print(const void *value, uint16_t count)
+{
+  int32_t sum;
+
+  memcpy(&sum, value, sizeof(int32_t));
+  printf(" v %ld", count > 0 ? sum / count : 0L);
+}
+/*---------------------------------------------------------------------------*/
+static void
+hist_init(void *value, int16_t sample)
+{
+  uint8_t *bins = value;
+  int16_t bin;
+
+  memset(bins, 0, CSYNC_AGG_HIST_BINS);
+  bin = (sample - CSYNC_AGG_HIST_MIN) / CSYNC_AGG_HIST_WIDTH;
+  if(sample < CSYNC_AGG_HIST_MIN)
+  {
+    bin = 0;
+  }
+  else if(bin >= CSYNC_AGG_HIST_BINS)
+  {
+    bin = CSYNC_AGG_HIST_BINS - 1;
+  }
+  bins[bin] = 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+hist_merge(void *value, const void *other)
+{
+  uint8_t *bins = value;
+  const uint8_t *other_bins = other;
+  uint8_t i;
+
+  for(i = 0; i < CSYNC_AGG_HIST_BINS; i++)
+  {
+    bins[i] = bins[i] + other_bins[i] < 0xff ? bins[i] + other_bins[i] : 0xff;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+hist_print(const void *value, uint16_t count)
+{
+  const uint8_t *bins = value;
+  uint8_t i;
+
+  for(i = 0; i < CSYNC_AGG_HIST_BINS; i++)
+  {
+    printf(" %u", bins[i]);
+  }
+}
+/*---------------------------------------------------------------------------*/
+const struct csync_agg_operator csync_agg_min =
+  {"min", sizeof(int16_t), scalar_init, min_merge, scalar_print};
+const struct csync_agg_operator csync_agg_max =
+  {"max", sizeof(int16_t), scalar_init, max_merge, scalar_print};
+const struct csync_agg_operator csync_agg_avg =
+  {"avg", sizeof(int32_t), avg_init, avg_merge, avg_print};
+const struct csync_agg_operator csync_agg_histogram =
+  {"hist", CSYNC_AGG_HIST_BINS, hist_init, hist_merge, hist_print};
+/*---------------------------------------------------------------------------*/
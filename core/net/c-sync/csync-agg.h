@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+
+/**
+ * \file
+ *         In-network aggregation over the C-sync cluster hierarchy
+ *
+ *         Every IDLE period is one aggregation round. The sink floods a
+ *         small beacon through the CHs and CBs, which builds a tree of
+ *         CH -> CB -> CH hops towards the sink. CMs send their sample to
+ *         their CH in the slot given by my_placing, or in their TDMA
+ *         slot when the slotted MAC (CSYNC_TDMA) runs. CHs and CBs merge
+ *         everything they receive with their own sample and send one
+ *         frame to their parent, deepest level first, so each cluster
+ *         costs one upstream transmission per round. A CH or CB that
+ *         has not heard a beacon by its turn keeps merging and sends its
+ *         aggregate as soon as one arrives.
+ *
+ *         The merge is done by a pluggable operator. min, max, avg and
+ *         histogram are provided, sync_error merges the sync-error
+ *         histograms of csync-hist.h.
+ */
+
+#ifndef CSYNC_AGG_H_
+#define CSYNC_AGG_H_
+
+#include "contiki.h"
+#include "net/c-sync/csync-hist.h"
+
+#ifdef CSYNC_AGG_CONF_SINK
+#define CSYNC_AGG_SINK CSYNC_AGG_CONF_SINK
+#else
+#define CSYNC_AGG_SINK 1 // node address of the sink
+#endif
+
+/* 0 forwards every sample on its own instead of merging, as a
+   baseline for the number of transmissions per round. */
+#ifdef CSYNC_AGG_CONF_MERGE
+#define CSYNC_AGG_MERGE CSYNC_AGG_CONF_MERGE
+#else
+#define CSYNC_AGG_MERGE 1
+#endif
+
+#ifdef CSYNC_AGG_CONF_MAX_DEPTH
+#define CSYNC_AGG_MAX_DEPTH CSYNC_AGG_CONF_MAX_DEPTH
+#else
+#define CSYNC_AGG_MAX_DEPTH 6 // CH and CB hops between sink and the farthest node
+#endif
+
+/* Round timing, relative to the start of IDLE. It has to fit into
+   IDLE_SLOT_INTERVAL. */
+#ifdef CSYNC_AGG_CONF_MEMBER_SLOT
+#define CSYNC_AGG_MEMBER_SLOT CSYNC_AGG_CONF_MEMBER_SLOT
+#else
+#define CSYNC_AGG_MEMBER_SLOT (CLOCK_SECOND / 32)
+#endif
+
+#ifdef CSYNC_AGG_CONF_LEVEL_INTERVAL
+#define CSYNC_AGG_LEVEL_INTERVAL CSYNC_AGG_CONF_LEVEL_INTERVAL
+#else
+#define CSYNC_AGG_LEVEL_INTERVAL (CLOCK_SECOND / 8)
+#endif
+
+#ifdef CSYNC_AGG_CONF_MEMBER_SLOTS
+#define CSYNC_AGG_MEMBER_SLOTS CSYNC_AGG_CONF_MEMBER_SLOTS
+#else
+#define CSYNC_AGG_MEMBER_SLOTS 16
+#endif
+
+#define CSYNC_AGG_MEMBER_START (CLOCK_SECOND / 8)
+#define CSYNC_AGG_UPSTREAM_START (CSYNC_AGG_MEMBER_START + CSYNC_AGG_MEMBER_SLOTS * CSYNC_AGG_MEMBER_SLOT)
+#define CSYNC_AGG_ROUND_END (CSYNC_AGG_UPSTREAM_START + (CSYNC_AGG_MAX_DEPTH + 1) * CSYNC_AGG_LEVEL_INTERVAL)
+
+#ifdef CSYNC_AGG_CONF_HIST_BINS
+#define CSYNC_AGG_HIST_BINS CSYNC_AGG_CONF_HIST_BINS
+#else
+#define CSYNC_AGG_HIST_BINS 8
+#endif
+
+#ifdef CSYNC_AGG_CONF_HIST_MIN
+#define CSYNC_AGG_HIST_MIN CSYNC_AGG_CONF_HIST_MIN
+#else
+#define CSYNC_AGG_HIST_MIN 0
+#endif
+
+#ifdef CSYNC_AGG_CONF_HIST_WIDTH
+#define CSYNC_AGG_HIST_WIDTH CSYNC_AGG_CONF_HIST_WIDTH
+#else
+#define CSYNC_AGG_HIST_WIDTH 16
+#endif
+
+/* Largest value of the operators below, csync_agg_sync_error carries
+   CSYNC_HIST_BINS 16 bit bins */
+#define CSYNC_AGG_VALUE_MAX (CSYNC_AGG_HIST_BINS > 2 * CSYNC_HIST_BINS ? CSYNC_AGG_HIST_BINS : 2 * CSYNC_HIST_BINS)
+#define CSYNC_AGG_CHANNEL 15 // beacons, CSYNC_AGG_CHANNEL + 1 for the aggregates
+
+/**
+ * An aggregation operator works on an opaque value of value_len
+ * bytes. init() turns one sample into a value, merge() folds other
+ * into value. print() is used by the default sink callback.
+ */
+struct csync_agg_operator {
+  char *name;
+  uint8_t value_len;
+  void (* init)(void *value, int16_t sample);
+  void (* merge)(void *value, const void *other);
+  void (* print)(const void *value, uint16_t count);
+};
+
+extern const struct csync_agg_operator csync_agg_min;
+extern const struct csync_agg_operator csync_agg_max;
+extern const struct csync_agg_operator csync_agg_avg;
+extern const struct csync_agg_operator csync_agg_histogram;
+extern const struct csync_agg_operator csync_agg_sync_error; // csync-hist.c
+
+typedef int16_t (* csync_agg_sample_t)(void);
+typedef void (* csync_agg_callback_t)(const struct csync_agg_operator *op,
+                                      const void *value, uint16_t count);
+
+struct csync_agg_stats {
+  uint8_t round;
+  uint8_t hops;       /// << distance to the sink, 0xff if no beacon was heard
+  uint16_t tx;        /// << beacons and aggregates sent in this round
+  uint16_t rx;
+  uint16_t merged;
+};
+
+/**
+ * Open the service. sample is called once per round for the own
+ * value, callback is called on the sink when a round completes
+ * (NULL prints the result).
+ */
+void csync_agg_open(const struct csync_agg_operator *op,
+                    csync_agg_sample_t sample, csync_agg_callback_t callback);
+void csync_agg_close(void);
+
+/**
+ * Start a round, called by every node when it enters IDLE.
+ */
+void csync_agg_start_round(void);
+
+const struct csync_agg_stats *csync_agg_get_stats(void);
+void csync_agg_print_stats(void);
+
+#endif /* CSYNC_AGG_H_ */
@@ -0,0 +1,366 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Slotted IDLE beacons of C-sync
+ */
+
+#include "net/c-sync/c-sync.h"
+#include "net/c-sync/csync-beacon.h"
+#include "net/rime/broadcast-announcement.h"
+#include "net/netstack.h"
+#include "sys/cc.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define DEBUG 0
+#if DEBUG
+#define PRINTF(...) printf(__VA_ARGS__)
+#else
+#define PRINTF(...)
+#endif
+
+/* my_slot of a node that found no free slot in its block */
+#define NO_SLOT 0xFF
+
+typedef enum
+{
+  SLOT_NONE = 0,
+  SLOT_RX = 1,
+  SLOT_TX = 2,
+} slot_use_t;
+
+PROCESS(csync_beacon_process, "C-sync beacons");
+
+static struct csync_beacon_stats stats;
+
+static uint8_t active;
+static uint8_t my_slot;
+static uint8_t probing;             // listening in my_slot instead of beaconing
+static uint8_t heard[(CSYNC_BEACON_NUM_SLOTS + 7) / 8];
+
+static uint32_t start_coarse;
+static uint32_t start_fine;
+static uint32_t slot_count;         // slot the armed RTIMER_1 event belongs to
+static uint32_t current_slot;       // slot of the last event, the one in progress
+
+/*---------------------------------------------------------------------------*/
+static uint8_t
+wrap_cluster_slot(uint8_t slot)
+{
+  if(slot == 0)
+  {
+    return 1;
+  }
+  return ((slot - 1) % CSYNC_CONS_SLOTS) + 1;
+}
+
+/*---------------------------------------------------------------------------*/
+static slot_use_t
+slot_use(uint32_t n)
+{
+  uint8_t s = n % CSYNC_BEACON_NUM_SLOTS;
+
+  if(s == my_slot)
+  {
+    return SLOT_TX;
+  }
+  /* The first round listens to everything */
+  if(n < CSYNC_BEACON_NUM_SLOTS || (heard[s >> 3] & (1 << (s & 7))))
+  {
+    return SLOT_RX;
+  }
+  return SLOT_NONE;
+}
+
+/*---------------------------------------------------------------------------*/
+static uint32_t
+next_used_slot(uint32_t n)
+{
+  uint32_t last = n + CSYNC_BEACON_NUM_SLOTS;
+
+  for(; n < last; n++)
+  {
+    if(slot_use(n) != SLOT_NONE)
+    {
+      break;
+    }
+  }
+  return n;
+}
+
+/*---------------------------------------------------------------------------*/
+static char
+slot_callback(rtimer_t *rt)
+{
+  csync_wake(&csync_beacon_process);
+  return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+static uint8_t
+schedule_slot(uint32_t n)
+{
+  uint32_t interval = n * (uint32_t)CSYNC_BEACON_SLOT_INTERVAL;
+  uint32_t date_coarse = start_coarse + interval / RTIMER_FINE_MAX;
+  uint32_t date_fine = start_fine + interval % RTIMER_FINE_MAX;
+
+  if(RTIMER_FINE_MAX < date_fine)
+  {
+    date_coarse++;
+    date_fine -= RTIMER_FINE_MAX;
+  }
+
+  return rtimer_schedule(RTIMER_1, RTIMER_DATE, date_coarse, date_fine, slot_callback);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+schedule_from(uint32_t n)
+{
+  uint8_t tries;
+
+  /* A slot that is already too close is skipped, not sent late */
+  for(tries = 0; tries < CSYNC_BEACON_NUM_SLOTS; tries++)
+  {
+    slot_count = n;
+    if(schedule_slot(slot_count))
+    {
+      return;
+    }
+    stats.missed++;
+    n = next_used_slot(n + 1);
+  }
+  PRINTF("\nbeacon: could not schedule slot %lu", n);
+}
+
+/*---------------------------------------------------------------------------*/
+/* In round r, 1 <= r <= CSYNC_BEACON_PROBE_ROUNDS, a member listens in
+   its own slot instead of beaconing if bit r - 1 of its address is set.
+   Two members that share a slot differ in one of these bits, so one of
+   them hears the other */
+static uint8_t
+probe_round(uint32_t n)
+{
+  uint32_t round = n / CSYNC_BEACON_NUM_SLOTS;
+
+  return my_slot % CSYNC_BEACON_SLOTS_PER_CLUSTER != 0 &&
+         round >= 1 && round <= CSYNC_BEACON_PROBE_ROUNDS &&
+         (my_addr >> (round - 1)) & 1;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Takes the first slot of the block no beacon was heard in during the
+   first round, or gives up beaconing if there is none */
+static void
+move_slot(void)
+{
+  uint8_t first = my_slot - my_slot % CSYNC_BEACON_SLOTS_PER_CLUSTER;
+  uint8_t s;
+
+  stats.collisions++;
+  for(s = first + 1; s < first + CSYNC_BEACON_SLOTS_PER_CLUSTER; s++)
+  {
+    if(s != my_slot && !(heard[s >> 3] & (1 << (s & 7))))
+    {
+      my_slot = s;
+      return;
+    }
+  }
+  my_slot = NO_SLOT;
+}
+
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(csync_beacon_process, ev, data)
+{
+  slot_use_t use;
+
+  PROCESS_BEGIN();
+
+  while(1)
+  {
+    PROCESS_YIELD_UNTIL(ev == PROCESS_EVENT_POLL);
+
+    if(!active)
+    {
+      continue;
+    }
+
+    current_slot = slot_count;
+    stats.rounds = current_slot / CSYNC_BEACON_NUM_SLOTS + 1;
+    probing = 0;
+
+    use = slot_use(slot_count);
+    if(use == SLOT_NONE)
+    {
+#if CSYNC_BEACON_DUTY_CYCLE
+      NETSTACK_RADIO.off();
+#endif
+      schedule_from(next_used_slot(slot_count + 1));
+      continue;
+    }
+
+    /* Arm the next event before transmitting, slots are short */
+    schedule_from(slot_count + 1);
+
+    NETSTACK_RADIO.on();
+    if(use == SLOT_TX)
+    {
+      if(probe_round(current_slot))
+      {
+        probing = 1;
+      }
+      else
+      {
+        broadcast_announcement_send();
+        stats.sent++;
+      }
+    }
+  }
+
+  PROCESS_END();
+}
+
+/*---------------------------------------------------------------------------*/
+void
+csync_beacon_start(uint32_t date_coarse, uint32_t date_fine)
+{
+  struct CHB *ch;
+  uint8_t block, local;
+
+  if(!process_is_running(&csync_beacon_process))
+  {
+    process_start(&csync_beacon_process, NULL);
+  }
+
+  if(my_cluster.role == CH)
+  {
+    block = wrap_cluster_slot(my_cons_slot);
+    local = 0;
+  }
+  else
+  {
+    ch = list_head(*my_cluster.CHs_list);
+    if(my_cluster.role == CB && ch != NULL && ch->cons_slot != 0)
+    {
+      block = wrap_cluster_slot(ch->cons_slot);
+    }
+    else
+    {
+      block = wrap_cluster_slot(my_cons_slot);
+    }
+    /* Placings beyond the block share its last slot until the probe
+       rounds spread them */
+    local = 1 + MIN(my_placing, CSYNC_BEACON_SLOTS_PER_CLUSTER - 2);
+  }
+  my_slot = (block - 1) * CSYNC_BEACON_SLOTS_PER_CLUSTER + local;
+
+  start_coarse = date_coarse;
+  start_fine = date_fine;
+  memset(heard, 0, sizeof(heard));
+  memset(&stats, 0, sizeof(stats));
+  probing = 0;
+
+  broadcast_announcement_set_slotted(1);
+  active = 1;
+
+  /* Slot 0 starts at the reference itself, which has already passed */
+  current_slot = 0;
+  schedule_from(1);
+
+  PRINTF("\nbeacon: slot %u of %u", my_slot, CSYNC_BEACON_NUM_SLOTS);
+}
+
+/*---------------------------------------------------------------------------*/
+void
+csync_beacon_stop(void)
+{
+  active = 0;
+  rtimer_cancel(RTIMER_1);
+  broadcast_announcement_set_slotted(0);
+  NETSTACK_RADIO.on();
+}
+
+/*---------------------------------------------------------------------------*/
+void
+csync_beacon_heard(const linkaddr_t *from)
+{
+  uint8_t s = current_slot % CSYNC_BEACON_NUM_SLOTS;
+
+  if(!active)
+  {
+    return;
+  }
+
+  if(s == my_slot)
+  {
+    if(probing)
+    {
+      PRINTF("\nbeacon: slot %u taken by %u", my_slot, from->u16);
+      probing = 0;
+      move_slot();
+    }
+    return;
+  }
+
+  /* The first round listens to every slot */
+  if(current_slot < CSYNC_BEACON_NUM_SLOTS && !(heard[s >> 3] & (1 << (s & 7))))
+  {
+    heard[s >> 3] |= 1 << (s & 7);
+    stats.heard_slots++;
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+uint8_t
+csync_beacon_my_slot(void)
+{
+  return my_slot;
+}
+
+/*---------------------------------------------------------------------------*/
+const struct csync_beacon_stats *
+csync_beacon_get_stats(void)
+{
+  return &stats;
+}
+
+/*---------------------------------------------------------------------------*/
+void
+csync_beacon_print_stats(void)
+{
+  printf("\n%u BS slot %u r %u s %u h %u m %u c %u", my_addr, my_slot,
+         stats.rounds, stats.sent, stats.heard_slots, stats.missed,
+         stats.collisions);
+}
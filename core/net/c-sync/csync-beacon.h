@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Slotted IDLE beacons of C-sync
+ *
+ *         Instead of the random beacon times of broadcast-announcement,
+ *         every node beacons once per round in its own micro-slot,
+ *         scheduled on logical time from the common IDLE reference.
+ *         Like csync-tdma, the rounds are split into one block of
+ *         CSYNC_BEACON_SLOTS_PER_CLUSTER slots per consensus slot: the
+ *         CH beacons in the first slot of its block, the other nodes
+ *         in the slot given by my_placing. A CB uses the block of its
+ *         first CH.
+ *
+ *         The first round of every IDLE period listens to all slots
+ *         and notes the ones a beacon was heard in. Later rounds only
+ *         turn the radio on for those slots and the own one.
+ *
+ *         my_placing is not unique, so members check their slot in
+ *         the next CSYNC_BEACON_PROBE_ROUNDS rounds: a member listens
+ *         instead of beaconing in round r if bit r - 1 of its address
+ *         is set. A member that hears a beacon in its own slot moves
+ *         to a slot of its block that was silent in the first round.
+ *         It stops beaconing if there is none.
+ */
+
+#ifndef CSYNC_BEACON_H_
+#define CSYNC_BEACON_H_
+
+#include "contiki.h"
+#include "net/c-sync/csync-coloring.h"
+
+#ifndef CSYNC_BEACON
+#define CSYNC_BEACON 0
+#endif
+
+#if CSYNC_BEACON && CSYNC_TDMA
+#error "CSYNC_BEACON and CSYNC_TDMA both drive RTIMER_1"
+#endif
+
+#ifdef CSYNC_BEACON_CONF_SLOT_INTERVAL
+#define CSYNC_BEACON_SLOT_INTERVAL CSYNC_BEACON_CONF_SLOT_INTERVAL
+#else
+#define CSYNC_BEACON_SLOT_INTERVAL (RTIMER_HF_SECOND / 128) // ~8 ms, one beacon and the CSMA backoff
+#endif
+
+#ifdef CSYNC_BEACON_CONF_SLOTS_PER_CLUSTER
+#define CSYNC_BEACON_SLOTS_PER_CLUSTER CSYNC_BEACON_CONF_SLOTS_PER_CLUSTER
+#else
+#define CSYNC_BEACON_SLOTS_PER_CLUSTER 8 // first slot belongs to the CH
+#endif
+
+/* Only the own and the learned slots keep the radio on. Other IDLE
+   traffic needs it on all the time. */
+#ifdef CSYNC_BEACON_CONF_DUTY_CYCLE
+#define CSYNC_BEACON_DUTY_CYCLE CSYNC_BEACON_CONF_DUTY_CYCLE
+#else
+#define CSYNC_BEACON_DUTY_CYCLE !(CSYNC_AGG || CSYNC_DATA_LOAD)
+#endif
+
+/* Enough to tell 8-bit node addresses apart */
+#ifdef CSYNC_BEACON_CONF_PROBE_ROUNDS
+#define CSYNC_BEACON_PROBE_ROUNDS CSYNC_BEACON_CONF_PROBE_ROUNDS
+#else
+#define CSYNC_BEACON_PROBE_ROUNDS 8
+#endif
+
+#define CSYNC_BEACON_NUM_SLOTS (CSYNC_CONS_SLOTS * CSYNC_BEACON_SLOTS_PER_CLUSTER)
+
+struct csync_beacon_stats {
+  uint16_t rounds;
+  uint16_t sent;
+  uint8_t heard_slots;   /// << slots with a neighbour beacon in the first round
+  uint16_t missed;       /// << slots that could not be scheduled in time
+  uint8_t collisions;    /// << own slot found in use while probing
+};
+
+/**
+ * Beacon from the logical date (coarse, fine) on, the start of IDLE,
+ * which is common to all nodes. The announcements to send must be set
+ * and broadcast_announcement_init() called before.
+ */
+void csync_beacon_start(uint32_t date_coarse, uint32_t date_fine);
+void csync_beacon_stop(void);
+
+/**
+ * To be called for every IDLE beacon received, in the slot it was
+ * received in. Other announcements do not count.
+ */
+void csync_beacon_heard(const linkaddr_t *from);
+uint8_t csync_beacon_my_slot(void);
+
+const struct csync_beacon_stats *csync_beacon_get_stats(void);
+void csync_beacon_print_stats(void);
+
+#endif /* CSYNC_BEACON_H_ */
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Per-cluster radio channels for the consensus synchronization
+ */
+
+#include "net/c-sync/c-sync.h"
+#include "net/c-sync/csync-channel.h"
+
+static const uint8_t channels[] = CSYNC_MULTICHANNEL_CHANNELS;
+#define NUM_CHANNELS (sizeof(channels) / sizeof(channels[0]))
+
+static uint8_t default_channel;
+static uint8_t current;
+static uint16_t hops;
+
+/*---------------------------------------------------------------------------*/
+static void
+tune(uint8_t channel)
+{
+  if(channel == current)
+  {
+    return;
+  }
+  cc2420_set_channel(channel);
+  current = channel;
+  hops++;
+}
+/*---------------------------------------------------------------------------*/
+void
+csync_channel_init(void)
+{
+  default_channel = cc2420_get_channel();
+  current = default_channel;
+  hops = 0;
+}
+/*---------------------------------------------------------------------------*/
+uint8_t
+csync_channel_of(uint16_t ch_addr)
+{
+  if(ch_addr == 0)
+  {
+    return default_channel;
+  }
+  return channels[ch_addr % NUM_CHANNELS];
+}
+/*---------------------------------------------------------------------------*/
+void
+csync_channel_cluster(void)
+{
+  struct CHB *ch;
+
+  if(my_cluster.role == CH)
+  {
+    tune(csync_channel_of(my_addr));
+    return;
+  }
+
+  /* CMs follow their CH, CBs start on the reference CH */
+  ch = list_head(*my_cluster.CHs_list);
+  if(my_cluster.role == CB)
+  {
+    for(; ch != NULL; ch = list_item_next(ch))
+    {
+      if(ch->addr == ref_n_CHB_addr)
+      {
+        break;
+      }
+    }
+    if(ch == NULL)
+    {
+      ch = list_head(*my_cluster.CHs_list);
+    }
+  }
+  tune(ch != NULL ? csync_channel_of(ch->addr) : default_channel);
+}
+/*---------------------------------------------------------------------------*/
+void
+csync_channel_slot(uint8_t slot)
+{
+  struct CHB *ch;
+
+  if(my_cluster.role != CB)
+  {
+    return;
+  }
+
+  for(ch = list_head(*my_cluster.CHs_list); ch != NULL; ch = list_item_next(ch))
+  {
+    if(ch->cons_slot == slot)
+    {
+      tune(csync_channel_of(ch->addr));
+      return;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+csync_channel_restore(void)
+{
+  tune(default_channel);
+}
+/*---------------------------------------------------------------------------*/
+uint16_t
+csync_channel_hops(void)
+{
+  return hops;
+}
+/*---------------------------------------------------------------------------*/
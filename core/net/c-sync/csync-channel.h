@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Per-cluster radio channels for the consensus synchronization
+ *
+ *         During CONSENSUS_SYNCHRONIZATION every cluster runs on the
+ *         802.15.4 channel of its CH, picked from the CH address, so
+ *         the polite announcements of neighbouring clusters no longer
+ *         collide. CHs and CMs tune once at the start of a pass, a CB
+ *         hops in every slot to the channel of the CH holding that
+ *         slot: it hears its reference CH in the slot of the latter and
+ *         relays to the other CH in its own. All nodes return to the
+ *         default channel before IDLE, where the beacons of C-sync and
+ *         the data plane need a common channel.
+ */
+
+#ifndef CSYNC_CHANNEL_H_
+#define CSYNC_CHANNEL_H_
+
+#include "contiki-conf.h"
+
+/* Channels outside of the three common 802.11 channels (1, 6, 11) */
+#ifdef CSYNC_MULTICHANNEL_CONF_CHANNELS
+#define CSYNC_MULTICHANNEL_CHANNELS CSYNC_MULTICHANNEL_CONF_CHANNELS
+#else
+#define CSYNC_MULTICHANNEL_CHANNELS { 15, 20, 25, 26 }
+#endif
+
+/**
+ * Remember the channel the radio was initialized on, to return to it.
+ */
+void csync_channel_init(void);
+
+/**
+ * Channel of the cluster of the CH with address ch_addr.
+ */
+uint8_t csync_channel_of(uint16_t ch_addr);
+
+/**
+ * Tune to the channel of the own cluster at the start of a pass.
+ */
+void csync_channel_cluster(void);
+
+/**
+ * Called at the start of every slot of a pass. A CB tunes to the
+ * channel of the CH holding the slot, other roles keep their channel.
+ */
+void csync_channel_slot(uint8_t slot);
+
+/**
+ * Return to the default channel.
+ */
+void csync_channel_restore(void);
+
+/**
+ * Number of channel switches since boot.
+ */
+uint16_t csync_channel_hops(void);
+
+#endif /* CSYNC_CHANNEL_H_ */
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Incremental handling of neighbour churn in C-sync
+ */
+
+#include "net/c-sync/c-sync.h"
+#include "net/c-sync/csync-churn.h"
+#include "net/c-sync/csync-phase.h"
+#include "net/rime/broadcast-announcement.h"
+
+#include <stdio.h>
+
+static struct csync_churn_stats stats;
+
+static uint8_t joined;
+static uint8_t lost;
+
+/*---------------------------------------------------------------------------*/
+static void
+clear_CHBs(list_t list, struct memb *m)
+{
+  struct CHB *c;
+
+  while((c = list_pop(list)) != NULL) {
+    memb_free(m, c);
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+csync_churn_reset(void)
+{
+  joined = 0;
+  lost = 0;
+}
+/*---------------------------------------------------------------------------*/
+uint8_t
+csync_churn_age(void)
+{
+  neighbour_t *n, *next;
+  uint16_t now = (uint16_t)clock_seconds();
+  uint8_t aged = 0;
+
+  for(n = list_head(csync_neighbour_list()); n != NULL; n = next) {
+    next = list_item_next(n);
+    if((uint16_t)(now - n->last_heard) > CSYNC_CHURN_TIMEOUT) {
+      csync_neighbour_remove(n);
+      aged++;
+    }
+  }
+  stats.aged += aged;
+
+  if(aged == 0 || my_cluster.role == CH) {
+    return CSYNC_CHURN_KEPT;
+  }
+
+  if(list_length(*my_cluster.CHs_list) == 0) {
+    lost = 1;
+    stats.lost++;
+    return CSYNC_CHURN_LOST;
+  }
+  if(my_cluster.role == CB && list_length(*my_cluster.CHs_list) == 1) {
+    my_cluster.role = CM;
+    stats.repairs++;
+    return CSYNC_CHURN_REPAIRED;
+  }
+  return CSYNC_CHURN_KEPT;
+}
+/*---------------------------------------------------------------------------*/
+uint8_t
+csync_churn_join(neighbour_t *n, const struct announcement_value *a_value)
+{
+  struct CHB *ch;
+
+  if(joined || a_value->instr != IDLE || a_value->ref_addr != n->addr || !n->synced) {
+    return 0;
+  }
+
+  /* Late nodes already counting down to ELECTION_REVELATION together
+     keep to it, their RTIMER_0 is not taken over */
+  if(rt[RTIMER_0].state == RTIMER_SCHEDULED) {
+    return 0;
+  }
+
+  /* The CH dated its beacon with the end of its IDLE, which is the
+     reference of its next consensus round */
+  if(!rtimer_schedule(RTIMER_0, RTIMER_DATE, a_value->date_coarse, a_value->date_fine, enter_discovery)) {
+    return 0;
+  }
+
+  clear_CHBs(*my_cluster.CHs_list, my_cluster.m_CH);
+  clear_CHBs(*my_cluster.CBs_list, my_cluster.m_CB);
+  ch = memb_alloc(my_cluster.m_CH);
+  if(ch == NULL) {
+    rtimer_cancel(RTIMER_0);
+    return 0;
+  }
+
+  broadcast_announcement_stop();
+  announcement_remove_value(&discovery_announcement);
+
+  ch->addr = n->addr;
+  ch->degree = n->degree;
+  ch->cons_slot = a_value->degree;
+  ch->n_CHB_addr_A = 0;
+  ch->n_CHB_addr_B = 0;
+  list_add(*my_cluster.CHs_list, ch);
+
+  n->role = CH;
+  my_cluster.role = CM;
+  my_state = IDLE;
+  CSYNC_PHASE_SWITCH(my_state);
+
+  joined = 1;
+  stats.joins++;
+  csync_wake(&c_gtsp_process);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+uint8_t
+csync_churn_joined(void)
+{
+  return joined;
+}
+/*---------------------------------------------------------------------------*/
+uint8_t
+csync_churn_lost(void)
+{
+  return lost;
+}
+/*---------------------------------------------------------------------------*/
+uint16_t
+csync_churn_cluster(void)
+{
+  struct CHB *ch;
+
+  if(my_cluster.role == CH) {
+    return my_addr;
+  }
+  ch = list_head(*my_cluster.CHs_list);
+  return ch == NULL ? 0 : ch->addr;
+}
+/*---------------------------------------------------------------------------*/
+const struct csync_churn_stats *
+csync_churn_get_stats(void)
+{
+  return &stats;
+}
+/*---------------------------------------------------------------------------*/
+void
+csync_churn_print_stats(void)
+{
+  printf("\n%u CC n %u a %u j %u r %u l %u", my_addr,
+         list_length(csync_neighbour_list()), stats.aged, stats.joins,
+         stats.repairs, stats.lost);
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Incremental handling of neighbour churn in C-sync
+ *
+ *         Without it, every node clusters again from DISCOVERY after
+ *         NUM_CONS_CTRL_ITERATIONS consensus rounds. With it, the
+ *         clusters are kept and the consensus rounds go on, while
+ *         changes are repaired where they happen:
+ *
+ *         - a neighbour not heard for CSYNC_CHURN_TIMEOUT seconds is
+ *           forgotten at the start of IDLE. A CB that lost one of its
+ *           CHs goes on as CM of the other one, a CM or CB left without
+ *           a CH goes back to DISCOVERY on its own.
+ *         - a node in DISCOVERY that hears the IDLE beacon of a CH it
+ *           is synced to joins that cluster as CM and follows its next
+ *           consensus round, unless it already counts down to its own
+ *           ELECTION_REVELATION. The beacon carries the address of the
+ *           CH of the sender in ref_addr and the consensus slot of that
+ *           CH in degree, in place of cons_ctrl_counter.
+ *
+ *         Joins need the IDLE beacons (IDLE_BROADCAST).
+ */
+
+#ifndef CSYNC_CHURN_H_
+#define CSYNC_CHURN_H_
+
+#include "net/c-sync/c-sync.h"
+
+#ifndef CSYNC_CHURN
+#define CSYNC_CHURN 0
+#endif
+
+#ifdef CSYNC_CHURN_CONF_TIMEOUT
+#define CSYNC_CHURN_TIMEOUT CSYNC_CHURN_CONF_TIMEOUT
+#else
+#define CSYNC_CHURN_TIMEOUT 30 // seconds, several consensus rounds
+#endif
+
+#if CSYNC_CHURN && NUM_CONS_CTRL_ITERATIONS < 2
+#error "CSYNC_CHURN needs NUM_CONS_CTRL_ITERATIONS >= 2"
+#endif
+
+/* Outcome of csync_churn_age() */
+#define CSYNC_CHURN_KEPT     0
+#define CSYNC_CHURN_REPAIRED 1 // role changed from CB to CM
+#define CSYNC_CHURN_LOST     2 // no CH left, back to DISCOVERY
+
+struct csync_churn_stats {
+  uint16_t aged;          /// << neighbours forgotten
+  uint16_t joins;         /// << clusters joined from DISCOVERY
+  uint16_t repairs;       /// << CB to CM
+  uint16_t lost;          /// << times the cluster was lost
+};
+
+/* Called by soft_reset() */
+void csync_churn_reset(void);
+
+/**
+ * Forgets the neighbours not heard for CSYNC_CHURN_TIMEOUT seconds
+ * and repairs the role, run at the start of IDLE.
+ */
+uint8_t csync_churn_age(void);
+
+/**
+ * Joins the cluster of n if a_value is the IDLE beacon of its CH,
+ * called in DISCOVERY. Returns 1 once RTIMER_0 is armed for the end
+ * of that IDLE and the node is CM of n.
+ */
+uint8_t csync_churn_join(neighbour_t *n, const struct announcement_value *a_value);
+
+uint8_t csync_churn_joined(void);
+uint8_t csync_churn_lost(void);
+
+/* Address of the CH of this node, 0 if it has none */
+uint16_t csync_churn_cluster(void);
+
+const struct csync_churn_stats *csync_churn_get_stats(void);
+void csync_churn_print_stats(void);
+
+#endif /* CSYNC_CHURN_H_ */
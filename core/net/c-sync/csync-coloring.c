@@ -32,67 +32,48 @@
 
 /**
  * \file
- *        Resilient Clustering in Contiki
- * \author
- *         Nitin Shivaraman <nitin.shivaraman@tum-create.edu.sg>
+ *         Spatial reuse of the consensus slots
  */
 
-
-
 #include "net/c-sync/c-sync.h"
+#include "net/c-sync/csync-coloring.h"
 
-void init_consensus_convergence(void)
+/*---------------------------------------------------------------------------*/
+uint8_t
+csync_coloring_may_claim(void)
 {
-	struct CHB *ch;
-	struct CHB *chch;
-
-    memb_init(my_cluster.m_CH);
-	list_init(*my_cluster.CHs_list);
+  struct CHB *ch;
 
-    for(ch = list_head(*my_cluster.CBs_list); ch != NULL; ch = list_item_next(ch))
+  for(ch = list_head(*my_cluster.CHs_list); ch != NULL; ch = list_item_next(ch))
+  {
+    if(ch->cons_slot == 0 && ch->addr > my_addr)
     {
-        for(chch = list_head(*my_cluster.CHs_list); chch != NULL; chch = list_item_next(chch))
-        {
-            if(ch->n_CHB_addr_A == chch->addr)
-            {
-            	chch->n_CHB_addr_B = ch->addr;
-            	break;
-            }
-        }
-
-        if(chch == NULL)
-        {
-		    chch = memb_alloc(my_cluster.m_CH);
-		    if(chch == NULL)
-		    {
-		        return;
-		    }
-		    chch->addr = ch->n_CHB_addr_A;
-		    chch->degree = ch->degree;
-		    chch->cons_slot = 0;
-		    chch->n_CHB_addr_A = ch->addr;
-		    chch->n_CHB_addr_B = 0;
-
-		    list_push(*my_cluster.CHs_list, chch);
-        }
+      return 0;
     }
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+uint8_t
+csync_coloring_pick(void)
+{
+  struct CHB *ch;
+  uint8_t colour;
 
-    switch(list_length(*my_cluster.CHs_list))
+  for(colour = 1; colour <= CSYNC_COLORING_SLOTS; colour++)
+  {
+    for(ch = list_head(*my_cluster.CHs_list); ch != NULL; ch = list_item_next(ch))
     {
-        case 0: case 1:
-            my_proactive_slot = 0;
-        break;
-        case 2:
-            my_proactive_slot = 1;
-        break;
-        case 3:
-            my_proactive_slot = 3;
-        break;
-        default:
-            my_proactive_slot = 3;
+      if(ch->cons_slot == colour)
+      {
         break;
+      }
     }
-    announcement_set_instr(&convergence_announcement, my_state);
-    
-
-}
\ No newline at end of file
+    if(ch == NULL)
+    {
+      return colour;
+    }
+  }
+  return CSYNC_COLORING_SLOTS + 1;
+}
+/*---------------------------------------------------------------------------*/
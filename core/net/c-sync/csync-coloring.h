@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Spatial reuse of the consensus slots
+ *
+ *         Without it, a CH claims a consensus slot once at most one
+ *         of its neighbouring CHs is left without one, so the number
+ *         of slots grows with the depth of the cluster graph and every
+ *         synchronization pass walks all NUM_CONS_SLOTS of them.
+ *
+ *         With CSYNC_COLORING the slots are colours of the cluster
+ *         graph, where two CHs conflict when they share a CB (they are
+ *         2 hops apart and the CB hears both). In every convergence
+ *         slot, a CH without a colour claims one when no uncoloured
+ *         neighbouring CH has a higher address, and takes the lowest
+ *         colour none of its neighbouring CHs holds. Clusters that do
+ *         not share a CB can thus hold the same slot, and every
+ *         synchronization pass (and the TDMA superframe) only walks
+ *         CSYNC_COLORING_SLOTS slots. NUM_CONS_SLOTS then only bounds
+ *         the number of claiming rounds of the convergence phase.
+ */
+
+#ifndef CSYNC_COLORING_H_
+#define CSYNC_COLORING_H_
+
+#include "contiki-conf.h"
+
+#ifndef CSYNC_COLORING
+#define CSYNC_COLORING 0
+#endif
+
+/* Upper bound on the chromatic number of the cluster graph of the
+   deployment. A CH left without a free colour gets no slot at all. */
+#ifdef CSYNC_COLORING_CONF_SLOTS
+#define CSYNC_COLORING_SLOTS CSYNC_COLORING_CONF_SLOTS
+#else
+#define CSYNC_COLORING_SLOTS 3
+#endif
+
+/* Slots walked by every synchronization pass */
+#if CSYNC_COLORING
+#define CSYNC_CONS_SLOTS CSYNC_COLORING_SLOTS
+#else
+#define CSYNC_CONS_SLOTS NUM_CONS_SLOTS
+#endif
+
+/**
+ * Returns 1 when the CH may claim a colour in the current convergence
+ * slot, that is when no neighbouring CH without a colour has a higher
+ * address.
+ */
+uint8_t csync_coloring_may_claim(void);
+
+/**
+ * Lowest colour not held by any neighbouring CH, or
+ * CSYNC_COLORING_SLOTS + 1 when all of them are taken.
+ */
+uint8_t csync_coloring_pick(void);
+
+#endif /* CSYNC_COLORING_H_ */
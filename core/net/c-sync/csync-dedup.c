@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Duplicate suppression for the announcements of C-sync
+ */
+
+#include "net/c-sync/c-sync.h"
+#include "net/c-sync/csync-dedup.h"
+
+#include <stdio.h>
+
+struct entry {
+  uint16_t addr;
+  uint16_t hash;
+  uint8_t id;
+  uint8_t tag;  /// << state and role of the node when delivered
+};
+
+static struct entry recent[CSYNC_DEDUP_SIZE];
+static uint8_t next_entry;
+static struct csync_dedup_stats stats;
+
+/*---------------------------------------------------------------------------*/
+/* 16 bit FNV-1a over the value as it was received */
+static uint16_t
+hash_value(const struct announcement_value *a_value)
+{
+  const uint8_t *p = (const uint8_t *)a_value;
+  uint32_t h = 2166136261UL;
+  uint8_t i;
+
+  for(i = 0; i < sizeof(struct announcement_value); i++)
+  {
+    h = (h ^ p[i]) * 16777619UL;
+  }
+  return (uint16_t)(h ^ (h >> 16));
+}
+/*---------------------------------------------------------------------------*/
+uint8_t
+csync_dedup_seen(uint16_t from, uint16_t id, const struct announcement_value *a_value)
+{
+  struct entry *e;
+  uint16_t hash = hash_value(a_value);
+  uint8_t tag = my_state | (my_cluster.role << 5);
+  uint8_t i;
+
+  for(i = 0; i < CSYNC_DEDUP_SIZE; i++)
+  {
+    e = &recent[i];
+    if(e->addr == from && e->hash == hash && e->id == id && e->tag == tag)
+    {
+      stats.suppressed++;
+      return 1;
+    }
+  }
+
+  /* Oldest entry goes */
+  e = &recent[next_entry];
+  e->addr = from;
+  e->hash = hash;
+  e->id = id;
+  e->tag = tag;
+  next_entry = (next_entry + 1) % CSYNC_DEDUP_SIZE;
+
+  stats.delivered++;
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+const struct csync_dedup_stats *
+csync_dedup_get_stats(void)
+{
+  return &stats;
+}
+/*---------------------------------------------------------------------------*/
+void
+csync_dedup_print_stats(void)
+{
+  printf("\n%u DUP d %u s %u", my_addr, stats.delivered, stats.suppressed);
+}
+/*---------------------------------------------------------------------------*/
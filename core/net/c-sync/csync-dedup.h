@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Duplicate suppression for the announcements of C-sync
+ *
+ *         A polite announcement is sent up to PA_RESILIENCE_MAX_SEND_DUPS
+ *         times, and every copy used to run the whole handler of its
+ *         phase. The handlers still pass every copy to add_to_neighbour(),
+ *         so GTSP gets all the timestamps, and then ask
+ *         csync_dedup_seen() whether the same sender already delivered
+ *         the same value. The small set of recent (sender, id, value
+ *         hash) entries is tagged with the state and role of the node,
+ *         so a copy heard after a phase or role change is handled again.
+ */
+
+#ifndef CSYNC_DEDUP_H_
+#define CSYNC_DEDUP_H_
+
+#include "net/rime/announcement.h"
+
+#ifndef CSYNC_DEDUP
+#define CSYNC_DEDUP 0
+#endif
+
+#ifdef CSYNC_DEDUP_CONF_SIZE
+#define CSYNC_DEDUP_SIZE CSYNC_DEDUP_CONF_SIZE
+#else
+#define CSYNC_DEDUP_SIZE 16
+#endif
+
+struct csync_dedup_stats {
+  uint16_t delivered;
+  uint16_t suppressed;
+};
+
+/**
+ * Returns 1 when the value was already delivered by the same sender in
+ * the current state and role, else remembers it and returns 0.
+ */
+uint8_t csync_dedup_seen(uint16_t from, uint16_t id, const struct announcement_value *a_value);
+
+const struct csync_dedup_stats *csync_dedup_get_stats(void);
+void csync_dedup_print_stats(void);
+
+#endif /* CSYNC_DEDUP_H_ */
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Sync-error histograms of C-sync
+ */
+
+#include "net/c-sync/csync-hist.h"
+#include "net/c-sync/csync-agg.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/* entries[0] is the overall one, a free entry has addr 0 */
+static struct csync_hist_entry entries[1 + CSYNC_HIST_NEIGHBOURS];
+
+/*---------------------------------------------------------------------------*/
+static uint8_t
+bucket(uint32_t v)
+{
+  uint8_t b = 0;
+
+  while(v != 0 && b < CSYNC_HIST_BINS - 1) {
+    v >>= 1;
+    b++;
+  }
+  return b;
+}
+/*---------------------------------------------------------------------------*/
+static void
+count(struct csync_hist *h, uint8_t b)
+{
+  if(h->bins[b] != 0xffff) {
+    h->bins[b]++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+add(struct csync_hist_entry *e, uint8_t offset_bucket, uint8_t jumped,
+    uint8_t rate_bucket)
+{
+  count(&e->offset, offset_bucket);
+  if(jumped) {
+    count(&e->jump, offset_bucket);
+  }
+  count(&e->rate, rate_bucket);
+}
+/*---------------------------------------------------------------------------*/
+static struct csync_hist_entry *
+lookup(uint16_t addr)
+{
+  struct csync_hist_entry *free = NULL;
+  uint8_t i;
+
+  for(i = 1; i <= CSYNC_HIST_NEIGHBOURS; i++) {
+    if(entries[i].addr == addr) {
+      return &entries[i];
+    }
+    if(free == NULL && entries[i].addr == 0) {
+      free = &entries[i];
+    }
+  }
+  if(free != NULL) {
+    free->addr = addr;
+  }
+  return free;
+}
+/*---------------------------------------------------------------------------*/
+void
+csync_hist_init(void)
+{
+  memset(entries, 0, sizeof(entries));
+}
+/*---------------------------------------------------------------------------*/
+void
+csync_hist_sample(const neighbour_t *n)
+{
+  struct csync_hist_entry *e;
+  uint8_t offset_bucket, rate_bucket;
+  double rate;
+
+  if(CSYNC_HIST_IDLE_ONLY && my_state != IDLE) {
+    return;
+  }
+
+  offset_bucket = bucket(n->fine_diff < 0 ? -n->fine_diff : n->fine_diff);
+  rate = n->relative_rate < 0 ? -n->relative_rate : n->relative_rate;
+  rate_bucket = bucket((uint32_t)(rate * 1000000));
+
+  add(&entries[0], offset_bucket, n->jumped, rate_bucket);
+  e = lookup(n->addr);
+  if(e != NULL) {
+    add(e, offset_bucket, n->jumped, rate_bucket);
+  }
+}
+/*---------------------------------------------------------------------------*/
+const struct csync_hist_entry *
+csync_hist_get(uint16_t addr)
+{
+  uint8_t i;
+
+  if(addr == CSYNC_HIST_ALL) {
+    return &entries[0];
+  }
+  for(i = 1; i <= CSYNC_HIST_NEIGHBOURS; i++) {
+    if(entries[i].addr == addr) {
+      return &entries[i];
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+void
+csync_hist_merge(struct csync_hist *h, const struct csync_hist *other)
+{
+  uint8_t i;
+  uint32_t sum;
+
+  for(i = 0; i < CSYNC_HIST_BINS; i++) {
+    sum = (uint32_t)h->bins[i] + other->bins[i];
+    h->bins[i] = sum < 0xffff ? sum : 0xffff;
+  }
+}
+/*---------------------------------------------------------------------------*/
+uint32_t
+csync_hist_count(const struct csync_hist *h)
+{
+  uint32_t total = 0;
+  uint8_t i;
+
+  for(i = 0; i < CSYNC_HIST_BINS; i++) {
+    total += h->bins[i];
+  }
+  return total;
+}
+/*---------------------------------------------------------------------------*/
+uint32_t
+csync_hist_percentile(const struct csync_hist *h, uint8_t percent)
+{
+  uint32_t total, rank, seen = 0;
+  uint8_t i;
+
+  total = csync_hist_count(h);
+  rank = (total * percent + 99) / 100;
+
+  for(i = 0; i < CSYNC_HIST_BINS - 1; i++) {
+    seen += h->bins[i];
+    if(seen >= rank) {
+      return (1UL << i) - 1;
+    }
+  }
+  return 0xffffffff;
+}
+/*---------------------------------------------------------------------------*/
+static uint8_t *
+put16(uint8_t *ptr, uint16_t v)
+{
+  ptr[0] = v & 0xff;
+  ptr[1] = v >> 8;
+  return ptr + 2;
+}
+/*---------------------------------------------------------------------------*/
+static uint8_t *
+put_hist(uint8_t *ptr, const struct csync_hist *h)
+{
+  uint8_t i;
+
+  for(i = 0; i < CSYNC_HIST_BINS; i++) {
+    ptr = put16(ptr, h->bins[i]);
+  }
+  return ptr;
+}
+/*---------------------------------------------------------------------------*/
+int
+csync_hist_dump(uint8_t *buf, int len)
+{
+  uint8_t *ptr = buf;
+  struct csync_hist_entry *e;
+  uint8_t i;
+
+  for(i = 0; i <= CSYNC_HIST_NEIGHBOURS; i++) {
+    e = &entries[i];
+    if(i > 0 && e->addr == 0) {
+      continue;
+    }
+    if(ptr + CSYNC_HIST_RECORD_LEN > buf + len) {
+      break;
+    }
+    ptr = put16(ptr, e->addr);
+    ptr = put_hist(ptr, &e->offset);
+    ptr = put_hist(ptr, &e->jump);
+    ptr = put_hist(ptr, &e->rate);
+  }
+  return ptr - buf;
+}
+/*---------------------------------------------------------------------------*/
+static void
+print_hist(const char *name, const struct csync_hist *h)
+{
+  uint8_t i;
+
+  printf(" %s", name);
+  for(i = 0; i < CSYNC_HIST_BINS; i++) {
+    printf(" %u", h->bins[i]);
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+csync_hist_print(void)
+{
+  struct csync_hist_entry *e;
+  uint8_t i;
+
+  for(i = 0; i <= CSYNC_HIST_NEIGHBOURS; i++) {
+    e = &entries[i];
+    if(i > 0 && e->addr == 0) {
+      continue;
+    }
+    printf("\n%u HS %u", my_addr, e->addr);
+    print_hist("o", &e->offset);
+    print_hist("j", &e->jump);
+    print_hist("r", &e->rate);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+print_percentiles(const struct csync_hist *h)
+{
+  printf(" n %lu p50 %lu p90 %lu p99 %lu", (unsigned long)csync_hist_count(h),
+         (unsigned long)csync_hist_percentile(h, 50),
+         (unsigned long)csync_hist_percentile(h, 90),
+         (unsigned long)csync_hist_percentile(h, 99));
+}
+/*---------------------------------------------------------------------------*/
+void
+csync_hist_print_percentiles(void)
+{
+  printf("\n%u HP", my_addr);
+  print_percentiles(&entries[0].offset);
+}
+/*---------------------------------------------------------------------------*/
+/* One line per node, hex encoded so it survives the serial log */
+void
+csync_hist_print_binary(void)
+{
+  static uint8_t buf[(1 + CSYNC_HIST_NEIGHBOURS) * CSYNC_HIST_RECORD_LEN];
+  int len, i;
+
+  len = csync_hist_dump(buf, sizeof(buf));
+  printf("\n%u HB ", my_addr);
+  for(i = 0; i < len; i++) {
+    printf("%02x", buf[i]);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Aggregation operator, the sample is not used: the value of a node is
+   its overall |fine_diff| histogram */
+/*---------------------------------------------------------------------------*/
+static void
+agg_init(void *value, int16_t sample)
+{
+  memcpy(value, &entries[0].offset, sizeof(struct csync_hist));
+}
+/*---------------------------------------------------------------------------*/
+static void
+agg_merge(void *value, const void *other)
+{
+  struct csync_hist a, b;
+
+  memcpy(&a, value, sizeof(struct csync_hist));
+  memcpy(&b, other, sizeof(struct csync_hist));
+  csync_hist_merge(&a, &b);
+  memcpy(value, &a, sizeof(struct csync_hist));
+}
+/*---------------------------------------------------------------------------*/
+static void
+agg_print(const void *value, uint16_t count)
+{
+  struct csync_hist h;
+
+  memcpy(&h, value, sizeof(struct csync_hist));
+  print_percentiles(&h);
+  print_hist("o", &h);
+}
+/*---------------------------------------------------------------------------*/
+const struct csync_agg_operator csync_agg_sync_error =
+  {"sync_error", sizeof(struct csync_hist), agg_init, agg_merge, agg_print};
+/*---------------------------------------------------------------------------*/
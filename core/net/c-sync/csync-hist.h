@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Sync-error histograms of C-sync
+ *
+ *         gtsp_recv() hands every sample to csync_hist_sample(), which
+ *         counts |fine_diff|, |fine_diff| of the samples GTSP flagged
+ *         as a jump and |relative_rate| in log2 buckets, per neighbour
+ *         and for all neighbours together. Bucket b > 0 holds the
+ *         values from 2^(b-1) to 2^b - 1, the last one everything
+ *         above. Histograms of different nodes are merged by adding
+ *         the bins, which is what csync_agg_sync_error does on its way
+ *         to the sink.
+ */
+
+#ifndef CSYNC_HIST_H_
+#define CSYNC_HIST_H_
+
+#include "net/c-sync/c-sync.h"
+
+#ifndef CSYNC_HIST
+#define CSYNC_HIST 0
+#endif
+
+#ifdef CSYNC_HIST_CONF_BINS
+#define CSYNC_HIST_BINS CSYNC_HIST_CONF_BINS
+#else
+#define CSYNC_HIST_BINS 10 // last bucket: 256 fine ticks or 256 ppm and above
+#endif
+
+#ifdef CSYNC_HIST_CONF_NEIGHBOURS
+#define CSYNC_HIST_NEIGHBOURS CSYNC_HIST_CONF_NEIGHBOURS
+#else
+#define CSYNC_HIST_NEIGHBOURS 6 // later neighbours only count in the overall entry
+#endif
+
+/* Only count the samples taken in IDLE, once the clusters are synced */
+#ifdef CSYNC_HIST_CONF_IDLE_ONLY
+#define CSYNC_HIST_IDLE_ONLY CSYNC_HIST_CONF_IDLE_ONLY
+#else
+#define CSYNC_HIST_IDLE_ONLY 1
+#endif
+
+#define CSYNC_HIST_ALL 0 // address of the overall entry
+
+struct csync_hist {
+  uint16_t bins[CSYNC_HIST_BINS];  /// << saturate at 0xffff
+};
+
+struct csync_hist_entry {
+  uint16_t addr;
+  struct csync_hist offset;        /// << |fine_diff| in fine ticks
+  struct csync_hist jump;          /// << |fine_diff| of the jumped samples
+  struct csync_hist rate;          /// << |relative_rate| in ppm
+};
+
+/* Size of one record in the binary dump: addr followed by the bins of
+   offset, jump and rate, little endian */
+#define CSYNC_HIST_RECORD_LEN (2 + 3 * 2 * CSYNC_HIST_BINS)
+
+void csync_hist_init(void);
+void csync_hist_sample(const neighbour_t *n);
+
+/**
+ * Returns the entry of addr, CSYNC_HIST_ALL for the overall one, or
+ * NULL if addr is not tracked.
+ */
+const struct csync_hist_entry *csync_hist_get(uint16_t addr);
+
+void csync_hist_merge(struct csync_hist *h, const struct csync_hist *other);
+uint32_t csync_hist_count(const struct csync_hist *h);
+
+/**
+ * Upper bound of the bucket that holds the percent-th percentile,
+ * 0xffffffff if it falls into the last bucket.
+ */
+uint32_t csync_hist_percentile(const struct csync_hist *h, uint8_t percent);
+
+int csync_hist_dump(uint8_t *buf, int len);
+
+void csync_hist_print(void);
+void csync_hist_print_percentiles(void);
+void csync_hist_print_binary(void);
+
+#endif /* CSYNC_HIST_H_ */
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+
+/**
+ * \file
+ *         Per-phase energy and message accounting for C-sync
+ */
+
+#include "net/c-sync/csync-phase.h"
+#include "net/rime/announcement.h"
+#include "sys/energest.h"
+
+#include <string.h>
+
+static struct csync_phase phases[CSYNC_PHASE_NUM];
+static uint8_t current;
+static volatile uint8_t flushing;
+
+static unsigned long last_cpu, last_lpm, last_transmit, last_listen;
+static clock_time_t last_time;
+static uint32_t last_sent, last_received;
+
+static const char *names[CSYNC_PHASE_NUM] = {
+  "DISC", "E_R", "E_D", "C_R", "C_D", "CONV", "CONS_R", "CONS_S", "IDLE", "BYZ"
+};
+
+/*---------------------------------------------------------------------------*/
+static void
+sample(unsigned long *cpu, unsigned long *lpm,
+       unsigned long *transmit, unsigned long *listen)
+{
+  energest_flush();
+  *cpu = energest_type_time(ENERGEST_TYPE_CPU);
+  *lpm = energest_type_time(ENERGEST_TYPE_LPM);
+  *transmit = energest_type_time(ENERGEST_TYPE_TRANSMIT);
+  *listen = energest_type_time(ENERGEST_TYPE_LISTEN);
+}
+/*---------------------------------------------------------------------------*/
+void
+csync_phase_flush(void)
+{
+  struct csync_phase *p;
+  unsigned long cpu, lpm, transmit, listen;
+  clock_time_t now;
+  spl_t s;
+
+  /* A switch from the rtimer interrupt while the process is flushing
+     only moves current, the rest is charged on the next flush. The
+     flag is tested and set with interrupts masked, so that only one
+     context flushes */
+  s = splhigh();
+  if(flushing) {
+    splx(s);
+    return;
+  }
+  flushing = 1;
+  splx(s);
+
+  p = &phases[current];
+  sample(&cpu, &lpm, &transmit, &listen);
+  now = clock_time();
+
+  p->cpu += cpu - last_cpu;
+  p->lpm += lpm - last_lpm;
+  p->transmit += transmit - last_transmit;
+  p->listen += listen - last_listen;
+  p->time += (clock_time_t)(now - last_time);
+  p->beacons_sent += announcement_counters.sent - last_sent;
+  p->beacons_received += announcement_counters.received - last_received;
+
+  last_cpu = cpu;
+  last_lpm = lpm;
+  last_transmit = transmit;
+  last_listen = listen;
+  last_time = now;
+  last_sent = announcement_counters.sent;
+  last_received = announcement_counters.received;
+  flushing = 0;
+}
+/*---------------------------------------------------------------------------*/
+void
+csync_phase_init(void)
+{
+  memset(phases, 0, sizeof(phases));
+  sample(&last_cpu, &last_lpm, &last_transmit, &last_listen);
+  last_time = clock_time();
+  last_sent = announcement_counters.sent;
+  last_received = announcement_counters.received;
+  current = CSYNC_PHASE_INDEX(DISCOVERY);
+  phases[current].entered = 1;
+}
+/*---------------------------------------------------------------------------*/
+void
+csync_phase_switch(state_t state)
+{
+  uint8_t next = CSYNC_PHASE_INDEX(state);
+
+  if(next >= CSYNC_PHASE_NUM || next == current) {
+    return;
+  }
+  csync_phase_flush();
+  current = next;
+  phases[current].entered++;
+}
+/*---------------------------------------------------------------------------*/
+const struct csync_phase *
+csync_phase_get(state_t state)
+{
+  if(CSYNC_PHASE_INDEX(state) >= CSYNC_PHASE_NUM) {
+    return NULL;
+  }
+  return &phases[CSYNC_PHASE_INDEX(state)];
+}
+/*---------------------------------------------------------------------------*/
+const char *
+csync_phase_name(state_t state)
+{
+  if(CSYNC_PHASE_INDEX(state) >= CSYNC_PHASE_NUM) {
+    return "?";
+  }
+  return names[CSYNC_PHASE_INDEX(state)];
+}
+/*---------------------------------------------------------------------------*/
+static uint8_t *
+put16(uint8_t *ptr, uint16_t v)
+{
+  ptr[0] = v & 0xff;
+  ptr[1] = v >> 8;
+  return ptr + 2;
+}
+/*---------------------------------------------------------------------------*/
+static uint8_t *
+put32(uint8_t *ptr, uint32_t v)
+{
+  ptr = put16(ptr, v & 0xffff);
+  return put16(ptr, v >> 16);
+}
+/*---------------------------------------------------------------------------*/
+int
+csync_phase_dump(uint8_t *buf, int len)
+{
+  uint8_t *ptr = buf;
+  struct csync_phase *p;
+  uint8_t i;
+
+  csync_phase_flush();
+
+  for(i = 0; i < CSYNC_PHASE_NUM; i++) {
+    p = &phases[i];
+    if(p->entered == 0) {
+      continue;
+    }
+    if(ptr + CSYNC_PHASE_RECORD_LEN > buf + len) {
+      break;
+    }
+    *ptr++ = i;
+    ptr = put32(ptr, p->cpu);
+    ptr = put32(ptr, p->lpm);
+    ptr = put32(ptr, p->transmit);
+    ptr = put32(ptr, p->listen);
+    ptr = put32(ptr, p->time);
+    ptr = put16(ptr, p->entered);
+    ptr = put16(ptr, p->beacons_sent);
+    ptr = put16(ptr, p->beacons_received);
+  }
+  return ptr - buf;
+}
+/*---------------------------------------------------------------------------*/
+void
+csync_phase_print(void)
+{
+  struct csync_phase *p;
+  uint8_t i;
+
+  csync_phase_flush();
+
+  for(i = 0; i < CSYNC_PHASE_NUM; i++) {
+    p = &phases[i];
+    if(p->entered == 0) {
+      continue;
+    }
+    printf("\n%u PH %s n %u t %lu cpu %lu lpm %lu tx %lu rx %lu bs %u br %u",
+           my_addr, names[i], p->entered, (unsigned long)p->time,
+           (unsigned long)p->cpu, (unsigned long)p->lpm,
+           (unsigned long)p->transmit, (unsigned long)p->listen,
+           p->beacons_sent, p->beacons_received);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* One line per node, hex encoded so it survives the serial log */
+void
+csync_phase_print_binary(void)
+{
+  static uint8_t buf[CSYNC_PHASE_NUM * CSYNC_PHASE_RECORD_LEN];
+  int len, i;
+
+  len = csync_phase_dump(buf, sizeof(buf));
+  printf("\n%u PB ", my_addr);
+  for(i = 0; i < len; i++) {
+    printf("%02x", buf[i]);
+  }
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+
+/**
+ * \file
+ *         Per-phase energy and message accounting for C-sync
+ *
+ *         The energest totals, the time and the announcement counters
+ *         are sampled whenever my_state changes, and the difference is
+ *         charged to the phase that is left. energest is masked while
+ *         IDLE (see ENERGEST_ON), so IDLE only gets time and beacons.
+ */
+
+#ifndef CSYNC_PHASE_H_
+#define CSYNC_PHASE_H_
+
+#include "net/c-sync/c-sync.h"
+
+#ifdef CSYNC_PHASE_CONF_STATS
+#define CSYNC_PHASE_STATS CSYNC_PHASE_CONF_STATS
+#else
+#define CSYNC_PHASE_STATS 1
+#endif
+
+#define CSYNC_PHASE_NUM ((BYZANTINE_CONSENSUS >> 1) + 1)
+#define CSYNC_PHASE_INDEX(state) ((state) >> 1)
+
+struct csync_phase {
+  uint32_t cpu;             /// << energest ticks
+  uint32_t lpm;
+  uint32_t transmit;
+  uint32_t listen;
+  uint32_t time;            /// << clock_time_t ticks spent in the phase
+  uint16_t entered;
+  uint16_t beacons_sent;
+  uint16_t beacons_received;
+};
+
+/* Size of one record in the binary dump: phase index followed by the
+   fields of struct csync_phase, little endian */
+#define CSYNC_PHASE_RECORD_LEN (1 + 5 * 4 + 3 * 2)
+
+#if CSYNC_PHASE_STATS
+#define CSYNC_PHASE_SWITCH(state) csync_phase_switch(state)
+#else
+#define CSYNC_PHASE_SWITCH(state)
+#endif
+
+void csync_phase_init(void);
+
+/**
+ * Charge everything since the last switch to the current phase and
+ * make state the current one. Safe to call from the rtimer callbacks.
+ */
+void csync_phase_switch(state_t state);
+void csync_phase_flush(void);
+
+const struct csync_phase *csync_phase_get(state_t state);
+const char *csync_phase_name(state_t state);
+
+/**
+ * Write the phases that were entered at least once to buf, returns the
+ * number of bytes written.
+ */
+int csync_phase_dump(uint8_t *buf, int len);
+
+void csync_phase_print(void);
+void csync_phase_print_binary(void);
+
+#endif /* CSYNC_PHASE_H_ */
@@ -32,77 +32,58 @@
 
 /**
  * \file
- *        Resilient Clustering in Contiki
- * \author
- *         Nitin Shivaraman <nitin.shivaraman@tum-create.edu.sg>
+ *         Sync-engine drivers of C-sync
+ *
+ *         The clustering and consensus phases only need three things
+ *         from the clock synchronization underneath: feed it the
+ *         timestamps of an announcement, let it correct the logical
+ *         clock, and ask whether the node is in sync. They go through
+ *         CSYNC_SYNC, selected with CSYNC_CONF_SYNC in project-conf.h
+ *         like the NETSTACK_* drivers, so GTSP and FTSP run on the
+ *         same clustering code.
  */
 
-
+#ifndef CSYNC_SYNC_H_
+#define CSYNC_SYNC_H_
 
 #include "net/c-sync/c-sync.h"
 
-void init_consensus_synchronization(void)
-{
-	struct CHB *ch;
+#ifndef CSYNC_SYNC
+#ifdef CSYNC_CONF_SYNC
+#define CSYNC_SYNC CSYNC_CONF_SYNC
+#else /* CSYNC_CONF_SYNC */
+#define CSYNC_SYNC gtsp_driver
+#endif /* CSYNC_CONF_SYNC */
+#endif /* CSYNC_SYNC */
+
+/**
+ * The structure of a sync-engine driver.
+ */
+struct csync_sync_driver {
+  char *name;
 
-    my_cons_slot = (NUM_CONS_SLOTS + 1) - my_cons_slot;
-    for(ch = list_head(*my_cluster.CHs_list); ch != NULL; ch = list_item_next(ch))
-    {
-        ch->cons_slot = (NUM_CONS_SLOTS + 1) - ch->cons_slot;
-    }
+  /** Forgets all samples, called by reset_c_gtsp(). */
+  void (* init)(void);
 
-    if(my_cluster.role == CH)
-    {
-        ref_n_CHB_degree = my_cons_slot;
-    }
-    else
-    {
-        ref_n_CHB_degree = NUM_CONS_SLOTS;
-    }
-    ref_n_CHB_addr = my_addr;
-    
+  /**
+   * Records the timestamps of syncframe as a sample of neighbour n
+   * and updates n->coarse_diff and n->fine_diff.
+   */
+  void (* recv)(neighbour_t *n, timesync_frame_t *syncframe, uint8_t new_neighbour);
 
-    if(my_cluster.role == CH)
-    {
-        my_sync_border = 1;
-    }
+  /**
+   * Corrects the logical clock. n is the neighbour whose sample was
+   * just recorded, neighbour_list the neighbours it belongs to.
+   */
+  void (* update)(list_t neighbour_list, neighbour_t *n);
 
-    for(ch = list_head(*my_cluster.CHs_list); ch != NULL; ch = list_item_next(ch))
-    {
-        if(ch->cons_slot < ref_n_CHB_degree)
-        {
-            ref_n_CHB_addr = ch->addr;
-            ref_n_CHB_degree = ch->cons_slot;
-            my_sync_border = 0;
-        }
-        else if(ch->cons_slot > NUM_CONS_SLOTS)
-        {
-            my_sync_border = 0;
-        }
-    }
+  /** Returns 1 when the logical clock follows the neighbours of neighbour_list. */
+  uint8_t (* synced)(list_t neighbour_list);
+};
 
-    if(my_cluster.role == CB)
-    {
-        for(ch = list_head(*my_cluster.CHs_list); ch != NULL; ch = list_item_next(ch))
-        {
-            if(ch->addr != ref_n_CHB_addr)
-            {
-                my_cons_slot = ch->cons_slot;
-            }
-        }
-    }
-}
+extern const struct csync_sync_driver CSYNC_SYNC;
 
-void update_consensus_synchronization(void)
-{
-    struct CHB *ch;
+extern const struct csync_sync_driver gtsp_driver;
+extern const struct csync_sync_driver ftsp_driver;
 
-    for(ch = list_head(*my_cluster.CHs_list); ch != NULL; ch = list_item_next(ch))
-    {
-        if(ch->addr == ref_n_CHB_addr)
-        {
-            break;
-        }
-        my_cons_slot = ch->cons_slot;
-    }
-}
+#endif /* CSYNC_SYNC_H_ */
@@ -0,0 +1,640 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Time-triggered TDMA MAC layer on top of the C-sync clusters
+ */
+
+#include "net/c-sync/c-sync.h"
+#include "net/c-sync/csync-tdma.h"
+#include "net/mac/csma.h"
+#include "net/packetbuf.h"
+#include "net/queuebuf.h"
+#include "net/netstack.h"
+#include "lib/dlist.h"
+#include "lib/random.h"
+#include "sys/cc.h"
+
+#include <string.h>
+
+#define DEBUG 0
+#if DEBUG
+#include <stdio.h>
+#define PRINTF(...) printf(__VA_ARGS__)
+#else
+#define PRINTF(...)
+#endif
+
+/* my_local_slot of a member the table has no slot for */
+#define NO_SLOT 0xFF
+
+typedef enum
+{
+  SLOT_NONE = 0,
+  SLOT_RX = 1,
+  SLOT_TX = 2,
+} slot_use_t;
+
+struct tdma_packet {
+  struct tdma_packet *next;
+  struct tdma_packet *prev;
+  struct queuebuf *buf;
+  mac_callback_t sent;
+  void *ptr;
+  clock_time_t queued_at;
+};
+
+/* Slot table sent by the CH in the first slot of its block */
+#define TABLE_MSG_HEADERLEN 4
+struct table_msg {
+  uint16_t ch_addr;
+  uint8_t  cluster_slot;
+  uint8_t  num;
+  uint16_t addr[CSYNC_TDMA_SLOTS_PER_CLUSTER - 1];
+};
+
+DLIST(packet_list);
+MEMB(packet_memb, struct tdma_packet, CSYNC_TDMA_QUEUE_LEN);
+
+PROCESS(csync_tdma_process, "C-sync TDMA");
+
+static struct broadcast_conn table_conn;
+static uint8_t table_conn_open;
+static struct csync_tdma_stats stats;
+
+static uint8_t active;
+static uint8_t in_slot;
+static uint8_t slot_budget;
+static uint8_t sending_table;
+
+static uint8_t my_cluster_slot;     // block of the cluster, 1..CSYNC_CONS_SLOTS
+static uint8_t my_local_slot;       // slot within the block, 0 for the CH, NO_SLOT if none
+static uint8_t table_heard;         // the table of the CH assigned my_local_slot
+static uint8_t bridge_cluster_slot; // second block a CB listens to, 0 if none
+
+static uint32_t start_coarse;
+static uint32_t start_fine;
+static uint32_t slot_count;         // slot the armed RTIMER_1 event belongs to
+static uint16_t seqno;
+
+/*---------------------------------------------------------------------------*/
+static uint8_t
+wrap_cluster_slot(uint8_t slot)
+{
+  if(slot == 0)
+  {
+    return 1;
+  }
+  return ((slot - 1) % CSYNC_CONS_SLOTS) + 1;
+}
+
+/*---------------------------------------------------------------------------*/
+static slot_use_t
+slot_use(uint32_t n)
+{
+  uint16_t s = n % CSYNC_TDMA_NUM_SLOTS;
+  uint8_t block = s / CSYNC_TDMA_SLOTS_PER_CLUSTER + 1;
+  uint8_t local = s % CSYNC_TDMA_SLOTS_PER_CLUSTER;
+
+  if(block == my_cluster_slot)
+  {
+    if(local == my_local_slot)
+    {
+      return SLOT_TX;
+    }
+    else if(my_cluster.role == CH || local == 0)
+    {
+      return SLOT_RX;
+    }
+  }
+  else if(block == bridge_cluster_slot && local == 0)
+  {
+    return SLOT_RX;
+  }
+  return SLOT_NONE;
+}
+
+/*---------------------------------------------------------------------------*/
+static uint32_t
+next_used_slot(uint32_t n)
+{
+  uint32_t last = n + CSYNC_TDMA_NUM_SLOTS;
+
+  for(; n < last; n++)
+  {
+    if(slot_use(n) != SLOT_NONE)
+    {
+      break;
+    }
+  }
+  return n;
+}
+
+/*---------------------------------------------------------------------------*/
+static char
+slot_callback(rtimer_t *rt)
+{
+  csync_wake(&csync_tdma_process);
+  return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+static uint8_t
+schedule_slot(uint32_t n)
+{
+  uint32_t interval = n * (uint32_t)CSYNC_TDMA_SLOT_INTERVAL;
+  uint32_t date_coarse = start_coarse + interval / RTIMER_FINE_MAX;
+  uint32_t date_fine = start_fine + interval % RTIMER_FINE_MAX;
+
+  if(RTIMER_FINE_MAX < date_fine)
+  {
+    date_coarse++;
+    date_fine -= RTIMER_FINE_MAX;
+  }
+
+  return rtimer_schedule(RTIMER_1, RTIMER_DATE, date_coarse, date_fine, slot_callback);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+schedule_from(uint32_t n)
+{
+  uint8_t tries;
+
+  /* A slot that is already too close is skipped, not sent late */
+  for(tries = 0; tries < CSYNC_TDMA_NUM_SLOTS; tries++)
+  {
+    slot_count = n;
+    if(schedule_slot(slot_count))
+    {
+      return;
+    }
+    n = next_used_slot(n + 1);
+  }
+  PRINTF("\ntdma: could not schedule slot %lu", n);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+packet_sent(void *ptr, int status, int num_transmissions)
+{
+  struct tdma_packet *p = ptr;
+  clock_time_t delay = clock_time() - p->queued_at;
+
+  if(status == MAC_TX_OK || status == MAC_TX_NOACK)
+  {
+    stats.sent++;
+    stats.latency_sum += delay;
+    if(delay > stats.latency_max)
+    {
+      stats.latency_max = delay;
+    }
+  }
+  else
+  {
+    stats.failed++;
+  }
+
+  queuebuf_free(p->buf);
+  mac_call_sent_callback(p->sent, p->ptr, status, num_transmissions);
+  memb_free(&packet_memb, p);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+flush_queue(void)
+{
+  struct tdma_packet *p;
+
+  while(slot_budget > 0 && (p = dlist_pop(packet_list)) != NULL)
+  {
+    slot_budget--;
+    queuebuf_to_packetbuf_view(p->buf);
+    NETSTACK_RDC.send(packet_sent, p);
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+drop_queue(void)
+{
+  struct tdma_packet *p;
+
+  while((p = dlist_pop(packet_list)) != NULL)
+  {
+    queuebuf_free(p->buf);
+    stats.dropped++;
+    mac_call_sent_callback(p->sent, p->ptr, MAC_TX_ERR, 0);
+    memb_free(&packet_memb, p);
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+send_table(void)
+{
+  struct table_msg *msg;
+  struct neighbour *n;
+  uint8_t degree[CSYNC_TDMA_SLOTS_PER_CLUSTER - 1];
+  uint8_t i;
+
+  packetbuf_clear();
+  msg = packetbuf_dataptr();
+  msg->ch_addr = my_addr;
+  msg->cluster_slot = my_cluster_slot;
+  msg->num = 0;
+
+  /* Members are ranked like my_placing: higher degree first, then higher address */
+  for(n = list_head(csync_neighbour_list()); n != NULL; n = list_item_next(n))
+  {
+    if(n->role == CH)
+    {
+      continue;
+    }
+
+    for(i = msg->num; i > 0; i--)
+    {
+      if(degree[i - 1] > n->degree || (degree[i - 1] == n->degree && msg->addr[i - 1] > n->addr))
+      {
+        break;
+      }
+      if(i < CSYNC_TDMA_SLOTS_PER_CLUSTER - 1)
+      {
+        degree[i] = degree[i - 1];
+        msg->addr[i] = msg->addr[i - 1];
+      }
+    }
+
+    if(i < CSYNC_TDMA_SLOTS_PER_CLUSTER - 1)
+    {
+      degree[i] = n->degree;
+      msg->addr[i] = n->addr;
+      if(msg->num < CSYNC_TDMA_SLOTS_PER_CLUSTER - 1)
+      {
+        msg->num++;
+      }
+    }
+  }
+
+  packetbuf_set_datalen(TABLE_MSG_HEADERLEN + msg->num * sizeof(uint16_t));
+
+  sending_table = 1;
+  broadcast_send(&table_conn);
+  sending_table = 0;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+table_received(struct broadcast_conn *c, const linkaddr_t *from)
+{
+  struct table_msg msg;
+  struct CHB *ch;
+  uint8_t i;
+
+  if(!active || my_cluster.role == CH || packetbuf_datalen() < TABLE_MSG_HEADERLEN)
+  {
+    return;
+  }
+
+  memset(&msg, 0, sizeof(msg));
+  memcpy(&msg, packetbuf_dataptr(), MIN(packetbuf_datalen(), sizeof(msg)));
+
+  ch = list_head(*my_cluster.CHs_list);
+  if(ch == NULL || ch->addr != msg.ch_addr)
+  {
+    if(my_cluster.role == CB && msg.cluster_slot != my_cluster_slot)
+    {
+      bridge_cluster_slot = wrap_cluster_slot(msg.cluster_slot);
+    }
+    return;
+  }
+
+  stats.tables_heard++;
+  table_heard = 1;
+  my_cluster_slot = wrap_cluster_slot(msg.cluster_slot);
+
+  /* Members the table has no room for do not send at all, sharing a
+     slot would only make them collide */
+  my_local_slot = NO_SLOT;
+  for(i = 0; i < msg.num && i < CSYNC_TDMA_SLOTS_PER_CLUSTER - 1; i++)
+  {
+    if(msg.addr[i] == my_addr)
+    {
+      my_local_slot = i + 1;
+      break;
+    }
+  }
+  if(my_local_slot == NO_SLOT)
+  {
+    drop_queue();
+  }
+}
+
+static const struct broadcast_callbacks table_callbacks = {table_received};
+
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(csync_tdma_process, ev, data)
+{
+  slot_use_t use;
+
+  PROCESS_BEGIN();
+
+  while(1)
+  {
+    PROCESS_YIELD_UNTIL(ev == PROCESS_EVENT_POLL);
+
+    if(!active)
+    {
+      continue;
+    }
+
+    use = slot_use(slot_count);
+    in_slot = 0;
+
+    if(use == SLOT_NONE)
+    {
+#if CSYNC_TDMA_DUTY_CYCLE
+      NETSTACK_RADIO.off();
+#endif
+      schedule_from(next_used_slot(slot_count + 1));
+      continue;
+    }
+
+    /* Arm the next event before transmitting, slots are short */
+    schedule_from(slot_count + 1);
+
+    NETSTACK_RADIO.on();
+    if(use == SLOT_TX)
+    {
+      in_slot = 1;
+      slot_budget = CSYNC_TDMA_MAX_PER_SLOT;
+      if(my_cluster.role == CH)
+      {
+        send_table();
+      }
+      flush_queue();
+    }
+  }
+
+  PROCESS_END();
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+send_packet(mac_callback_t sent, void *ptr)
+{
+  struct tdma_packet *p;
+
+  if(!active
+#if PACKETBUF_WITH_PACKET_TYPE
+     || packetbuf_attr(PACKETBUF_ATTR_PACKET_TYPE) == PACKETBUF_ATTR_PACKET_TYPE_TIMESTAMP
+#endif
+     )
+  {
+    /* C-sync control traffic keeps its contention based access */
+    csma_driver.send(sent, ptr);
+    return;
+  }
+
+  if(table_heard && my_local_slot == NO_SLOT)
+  {
+    PRINTF("\ntdma: no slot, dropping packet");
+    stats.dropped++;
+    mac_call_sent_callback(sent, ptr, MAC_TX_ERR, 0);
+    return;
+  }
+
+  if(seqno == 0)
+  {
+    seqno = random_rand();
+    if(seqno == 0)
+    {
+      seqno++;
+    }
+  }
+  packetbuf_set_attr(PACKETBUF_ATTR_MAC_SEQNO, seqno++);
+
+  p = memb_alloc(&packet_memb);
+  if(p != NULL)
+  {
+    p->buf = queuebuf_new_from_packetbuf();
+    if(p->buf != NULL)
+    {
+      p->sent = sent;
+      p->ptr = ptr;
+      p->queued_at = clock_time();
+      if(sending_table)
+      {
+        dlist_push(packet_list, p);
+      }
+      else
+      {
+        dlist_add(packet_list, p);
+      }
+      stats.queued++;
+
+      if(in_slot)
+      {
+        flush_queue();
+      }
+      return;
+    }
+    memb_free(&packet_memb, p);
+  }
+
+  PRINTF("\ntdma: queue full, dropping packet");
+  stats.dropped++;
+  mac_call_sent_callback(sent, ptr, MAC_TX_ERR, 0);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+input_packet(void)
+{
+  NETSTACK_LLSEC.input();
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+on(void)
+{
+  return NETSTACK_RDC.on();
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+off(int keep_radio_on)
+{
+  return NETSTACK_RDC.off(keep_radio_on);
+}
+
+/*---------------------------------------------------------------------------*/
+static unsigned short
+channel_check_interval(void)
+{
+  return csma_driver.channel_check_interval();
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+init(void)
+{
+  csma_driver.init();
+  memb_init(&packet_memb);
+  dlist_init(packet_list);
+  memset(&stats, 0, sizeof(stats));
+  active = 0;
+}
+
+/*---------------------------------------------------------------------------*/
+void
+csync_tdma_start(uint32_t date_coarse, uint32_t date_fine)
+{
+  struct CHB *ch;
+
+  if(!table_conn_open)
+  {
+    broadcast_open(&table_conn, CSYNC_TDMA_CHANNEL, &table_callbacks);
+    table_conn_open = 1;
+  }
+  if(!process_is_running(&csync_tdma_process))
+  {
+    process_start(&csync_tdma_process, NULL);
+  }
+
+  start_coarse = date_coarse;
+  start_fine = date_fine;
+  bridge_cluster_slot = 0;
+
+  if(my_cluster.role == CH)
+  {
+    my_cluster_slot = wrap_cluster_slot(my_cons_slot);
+    my_local_slot = 0;
+  }
+  else
+  {
+    ch = list_head(*my_cluster.CHs_list);
+    if(my_cluster.role == CB && ch != NULL && ch->cons_slot != 0)
+    {
+      my_cluster_slot = wrap_cluster_slot(ch->cons_slot);
+      ch = list_item_next(ch);
+      if(ch != NULL && ch->cons_slot != 0 && wrap_cluster_slot(ch->cons_slot) != my_cluster_slot)
+      {
+        bridge_cluster_slot = wrap_cluster_slot(ch->cons_slot);
+      }
+    }
+    else
+    {
+      my_cluster_slot = wrap_cluster_slot(my_cons_slot);
+    }
+    /* Queued until the table of the CH is heard, which is sent
+       in the first slot of the block */
+    my_local_slot = NO_SLOT;
+  }
+  table_heard = 0;
+
+  in_slot = 0;
+  active = 1;
+
+  /* Slot 0 starts at the reference itself, which has already passed */
+  schedule_from(next_used_slot(1));
+
+  PRINTF("\ntdma: block %u, slot %u", my_cluster_slot, my_local_slot);
+}
+
+/*---------------------------------------------------------------------------*/
+void
+csync_tdma_stop(void)
+{
+  struct tdma_packet *p;
+
+  active = 0;
+  in_slot = 0;
+  rtimer_cancel(RTIMER_1);
+
+  /* Hand whatever is left over to CSMA instead of dropping it */
+  while((p = dlist_pop(packet_list)) != NULL)
+  {
+    queuebuf_to_packetbuf_view(p->buf);
+    queuebuf_free(p->buf);
+    csma_driver.send(p->sent, p->ptr);
+    memb_free(&packet_memb, p);
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+uint8_t
+csync_tdma_is_active(void)
+{
+  return active;
+}
+
+/*---------------------------------------------------------------------------*/
+uint8_t
+csync_tdma_my_slot(void)
+{
+  if(my_local_slot == NO_SLOT)
+  {
+    return NO_SLOT;
+  }
+  return (my_cluster_slot - 1) * CSYNC_TDMA_SLOTS_PER_CLUSTER + my_local_slot;
+}
+
+/*---------------------------------------------------------------------------*/
+const struct csync_tdma_stats *
+csync_tdma_get_stats(void)
+{
+  return &stats;
+}
+
+/*---------------------------------------------------------------------------*/
+void
+csync_tdma_print_stats(void)
+{
+  printf(" tdma S%u q %u s %u d %u f %u t %u lat %lu/%u",
+         csync_tdma_my_slot(), stats.queued, stats.sent, stats.dropped, stats.failed,
+         stats.tables_heard, stats.sent ? stats.latency_sum / stats.sent : 0,
+         stats.latency_max);
+}
+
+/*---------------------------------------------------------------------------*/
+const struct mac_driver csync_tdma_driver = {
+  "C-sync TDMA",
+  init,
+  send_packet,
+  input_packet,
+  on,
+  off,
+  channel_check_interval,
+};
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Time-triggered TDMA MAC layer on top of the C-sync clusters
+ *
+ *         Once C-sync reaches IDLE, every cluster owns one block of
+ *         CSYNC_TDMA_SLOTS_PER_CLUSTER slots in the superframe,
+ *         selected by its consensus slot. The CH transmits its slot
+ *         table in the first slot of the block, members transmit in
+ *         the slot the table assigns to them. A member queues its
+ *         packets until the table is heard. The table has room for
+ *         CSYNC_TDMA_SLOTS_PER_CLUSTER - 1 members, the others drop
+ *         their packets instead of sharing a slot.
+ *
+ *         C-sync control traffic (timestamped announcements) and any
+ *         packet sent while the schedule is not running are handed
+ *         to csma_driver unchanged.
+ */
+
+#ifndef CSYNC_TDMA_H_
+#define CSYNC_TDMA_H_
+
+#include "net/mac/mac.h"
+#include "net/c-sync/csync-coloring.h"
+
+#ifdef CSYNC_TDMA_CONF_SLOT_INTERVAL
+#define CSYNC_TDMA_SLOT_INTERVAL CSYNC_TDMA_CONF_SLOT_INTERVAL
+#else
+#define CSYNC_TDMA_SLOT_INTERVAL (RTIMER_HF_SECOND / 100) // 10 ms
+#endif
+
+#ifdef CSYNC_TDMA_CONF_SLOTS_PER_CLUSTER
+#define CSYNC_TDMA_SLOTS_PER_CLUSTER CSYNC_TDMA_CONF_SLOTS_PER_CLUSTER
+#else
+#define CSYNC_TDMA_SLOTS_PER_CLUSTER 8 // first slot belongs to the CH
+#endif
+
+#ifdef CSYNC_TDMA_CONF_MAX_PER_SLOT
+#define CSYNC_TDMA_MAX_PER_SLOT CSYNC_TDMA_CONF_MAX_PER_SLOT
+#else
+#define CSYNC_TDMA_MAX_PER_SLOT 2 // two full 802.15.4 frames fit in 10 ms
+#endif
+
+#ifdef CSYNC_TDMA_CONF_QUEUE_LEN
+#define CSYNC_TDMA_QUEUE_LEN CSYNC_TDMA_CONF_QUEUE_LEN
+#else
+#define CSYNC_TDMA_QUEUE_LEN 4
+#endif
+
+/* Turn the radio off outside of the slots a node listens or sends in.
+   Only useful when the IDLE beacons of C-sync are switched off. */
+#ifdef CSYNC_TDMA_CONF_DUTY_CYCLE
+#define CSYNC_TDMA_DUTY_CYCLE CSYNC_TDMA_CONF_DUTY_CYCLE
+#else
+#define CSYNC_TDMA_DUTY_CYCLE !IDLE_BROADCAST
+#endif
+
+#define CSYNC_TDMA_CHANNEL 12
+#define CSYNC_TDMA_NUM_SLOTS (CSYNC_CONS_SLOTS * CSYNC_TDMA_SLOTS_PER_CLUSTER)
+
+struct csync_tdma_stats {
+  uint16_t queued;
+  uint16_t sent;
+  uint16_t dropped;      /// << queue full, schedule stopped or no slot
+  uint16_t failed;       /// << RDC reported an error
+  uint16_t tables_heard;
+  uint32_t latency_sum;  /// << queueing delay in clock_time_t ticks
+  uint16_t latency_max;
+};
+
+extern const struct mac_driver csync_tdma_driver;
+
+/**
+ * Start the slotted schedule at the logical date (coarse, fine),
+ * which is common to all nodes of the network (the IDLE reference).
+ */
+void csync_tdma_start(uint32_t date_coarse, uint32_t date_fine);
+void csync_tdma_stop(void);
+uint8_t csync_tdma_is_active(void);
+uint8_t csync_tdma_my_slot(void);
+
+const struct csync_tdma_stats *csync_tdma_get_stats(void);
+void csync_tdma_print_stats(void);
+
+#endif /* CSYNC_TDMA_H_ */
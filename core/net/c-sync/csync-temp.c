@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Temperature compensation of the C-sync clock rate
+ */
+
+#include "net/c-sync/c-sync.h"
+#include "net/c-sync/csync-temp.h"
+#include "sys/ctimer.h"
+#include "cfs/cfs.h"
+#if CSYNC_TEMP_INTERNAL
+#include "dev/temperature-sensor.h"
+#else /*CSYNC_TEMP_INTERNAL*/
+#include "dev/sht11/sht11-sensor.h"
+#endif /*CSYNC_TEMP_INTERNAL*/
+
+#include <stdio.h>
+#include <string.h>
+
+#define DEBUG 0
+#if DEBUG
+#define PRINTF(...) printf(__VA_ARGS__)
+#else
+#define PRINTF(...)
+#endif
+
+#define PPB 1000000000.0
+#define NO_BIN 0xff
+#define FILE_VERSION 1
+
+static struct csync_temp_bin table[CSYNC_TEMP_BINS];
+static struct csync_temp_stats stats;
+static struct ctimer sample_timer;
+static uint8_t (* synced_func)(void);
+static uint8_t last_bin = NO_BIN;
+static uint8_t unsaved;
+
+/*---------------------------------------------------------------------------*/
+/* Temperature in 1/100 degree C, returns 0 if the sensor did not answer */
+static uint8_t
+read_temp(int16_t *temp)
+{
+  int raw;
+
+#if CSYNC_TEMP_INTERNAL
+  uint32_t mv;
+
+  raw = temperature_sensor.value(0);
+  mv = (uint32_t)raw * 1500 / 4095;
+  *temp = ((int32_t)mv - 986) * 10000 / 355; // 3.55 mV per degree, 986 mV at 0 C
+#else /*CSYNC_TEMP_INTERNAL*/
+  raw = sht11_sensor.value(SHT11_SENSOR_TEMP);
+  if((unsigned)raw > 0x3fff) {
+    return 0;
+  }
+  *temp = -3960 + raw; // 14 bit, 3 V
+#endif /*CSYNC_TEMP_INTERNAL*/
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static uint8_t
+temp_to_bin(int16_t temp)
+{
+  int16_t t = temp - CSYNC_TEMP_MIN * 100;
+
+  if(t < 0) {
+    return 0;
+  }
+  t /= CSYNC_TEMP_STEP * 100;
+  return t < CSYNC_TEMP_BINS ? t : CSYNC_TEMP_BINS - 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+load(void)
+{
+  uint8_t header[2];
+  int fd;
+
+  fd = cfs_open(CSYNC_TEMP_FILE, CFS_READ);
+  if(fd < 0) {
+    return;
+  }
+  if(cfs_read(fd, header, sizeof(header)) == sizeof(header) &&
+     header[0] == FILE_VERSION && header[1] == CSYNC_TEMP_BINS &&
+     cfs_read(fd, table, sizeof(table)) == sizeof(table)) {
+    PRINTF("csync-temp: table loaded\n");
+  } else {
+    memset(table, 0, sizeof(table));
+  }
+  cfs_close(fd);
+}
+/*---------------------------------------------------------------------------*/
+static void
+save(void)
+{
+  uint8_t header[2] = {FILE_VERSION, CSYNC_TEMP_BINS};
+  int fd;
+
+  cfs_remove(CSYNC_TEMP_FILE);
+  fd = cfs_open(CSYNC_TEMP_FILE, CFS_WRITE);
+  if(fd < 0) {
+    return;
+  }
+  if(cfs_write(fd, header, sizeof(header)) == sizeof(header) &&
+     cfs_write(fd, table, sizeof(table)) == sizeof(table)) {
+    stats.saved++;
+    unsaved = 0;
+  }
+  cfs_close(fd);
+}
+/*---------------------------------------------------------------------------*/
+static void
+learn(uint8_t bin)
+{
+  struct csync_temp_bin *b = &table[bin];
+  int32_t rate = (int32_t)(RTIMER_AVG_RATE() * PPB);
+
+  if(b->weight == 0) {
+    b->rate = rate;
+  } else {
+    b->rate += (rate - b->rate) / 8;
+  }
+  if(b->weight < 0xffff) {
+    b->weight++;
+  }
+  stats.learned++;
+
+  if(++unsaved >= CSYNC_TEMP_SAVE_EVERY) {
+    save();
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+correct(uint8_t from, uint8_t to)
+{
+  int32_t rate_from, rate_to;
+
+  if(!csync_temp_predict(from, &rate_from) || !csync_temp_predict(to, &rate_to)
+     || rate_from == rate_to) {
+    return;
+  }
+  stats.last_correction = rate_to - rate_from;
+  stats.corrections++;
+  rtimer_set_avg_rate(RTIMER_AVG_RATE() + stats.last_correction / PPB);
+  PRINTF("csync-temp: bin %u -> %u, %ld ppb\n", from, to, (long)stats.last_correction);
+}
+/*---------------------------------------------------------------------------*/
+static void
+sample(void *ptr)
+{
+  int16_t temp;
+  uint8_t bin;
+
+  ctimer_reset(&sample_timer);
+
+  if(!read_temp(&temp)) {
+    return;
+  }
+  bin = temp_to_bin(temp);
+  stats.temp = temp;
+  stats.bin = bin;
+
+  /* GTSP and the consensus own avg_rate outside of IDLE */
+  if(my_state != IDLE) {
+    last_bin = bin;
+    return;
+  }
+
+  if(last_bin != NO_BIN && bin != last_bin) {
+    /* Learn again once the new bin was stable for one interval */
+    correct(last_bin, bin);
+  } else if(synced_func == NULL || synced_func()) {
+    learn(bin);
+  }
+  last_bin = bin;
+}
+/*---------------------------------------------------------------------------*/
+uint8_t
+csync_temp_predict(uint8_t bin, int32_t *rate)
+{
+  int8_t lo, hi;
+
+  for(lo = bin; lo >= 0 && table[lo].weight == 0; lo--);
+  for(hi = bin; hi < CSYNC_TEMP_BINS && table[hi].weight == 0; hi++);
+
+  if(lo < 0 && hi >= CSYNC_TEMP_BINS) {
+    return 0;
+  } else if(lo < 0) {
+    *rate = table[hi].rate;
+  } else if(hi >= CSYNC_TEMP_BINS || hi == lo) {
+    *rate = table[lo].rate;
+  } else {
+    *rate = table[lo].rate + (table[hi].rate - table[lo].rate) * (bin - lo) / (hi - lo);
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+void
+csync_temp_open(uint8_t (* synced)(void))
+{
+  synced_func = synced;
+  last_bin = NO_BIN;
+  memset(&stats, 0, sizeof(stats));
+  load();
+#if CSYNC_TEMP_INTERNAL
+  SENSORS_ACTIVATE(temperature_sensor);
+#else /*CSYNC_TEMP_INTERNAL*/
+  SENSORS_ACTIVATE(sht11_sensor);
+#endif /*CSYNC_TEMP_INTERNAL*/
+  ctimer_set(&sample_timer, CSYNC_TEMP_INTERVAL, sample, NULL);
+}
+/*---------------------------------------------------------------------------*/
+void
+csync_temp_close(void)
+{
+  ctimer_stop(&sample_timer);
+#if CSYNC_TEMP_INTERNAL
+  SENSORS_DEACTIVATE(temperature_sensor);
+#else /*CSYNC_TEMP_INTERNAL*/
+  SENSORS_DEACTIVATE(sht11_sensor);
+#endif /*CSYNC_TEMP_INTERNAL*/
+  if(unsaved) {
+    save();
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+csync_temp_clear(void)
+{
+  memset(table, 0, sizeof(table));
+  unsaved = 0;
+  cfs_remove(CSYNC_TEMP_FILE);
+}
+/*---------------------------------------------------------------------------*/
+const struct csync_temp_stats *
+csync_temp_get_stats(void)
+{
+  return &stats;
+}
+/*---------------------------------------------------------------------------*/
+void
+csync_temp_print_stats(void)
+{
+  printf("\n%u TC t %d b %u l %u c %u r %ld s %u", my_addr, stats.temp,
+         stats.bin, stats.learned, stats.corrections,
+         (long)stats.last_correction, stats.saved);
+}
+/*---------------------------------------------------------------------------*/
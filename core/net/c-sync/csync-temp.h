@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Temperature compensation of the C-sync clock rate
+ *
+ *         The rate of the 32 kHz crystal against its neighbours moves
+ *         with temperature, and GTSP only follows after a few beacons.
+ *         csync-temp samples a temperature sensor every
+ *         CSYNC_TEMP_INTERVAL. While the node is in IDLE and in sync,
+ *         the current avg_rate is learned into the bin of the current
+ *         temperature. When the temperature moves to another bin,
+ *         avg_rate is shifted by the difference the table predicts
+ *         between the two bins, before any neighbour sample arrives.
+ *         Bins without samples are interpolated between the nearest
+ *         learned ones. The table is kept in a Coffee file, so it
+ *         survives a reboot.
+ *
+ *         The SHT11 is read by bit-banging and blocks for up to
+ *         ~300 ms, the internal sensor of the MSP430 does not
+ *         (make CSYNC_TEMP_INTERNAL=1).
+ */
+
+#ifndef CSYNC_TEMP_H_
+#define CSYNC_TEMP_H_
+
+#include "contiki.h"
+
+#ifndef CSYNC_TEMP
+#define CSYNC_TEMP 0
+#endif
+
+#ifndef CSYNC_TEMP_INTERNAL
+#define CSYNC_TEMP_INTERNAL 0 // 0 for the SHT11, 1 for the MSP430 internal sensor
+#endif
+
+#ifdef CSYNC_TEMP_CONF_INTERVAL
+#define CSYNC_TEMP_INTERVAL CSYNC_TEMP_CONF_INTERVAL
+#else
+#define CSYNC_TEMP_INTERVAL (30 * CLOCK_SECOND)
+#endif
+
+#ifdef CSYNC_TEMP_CONF_MIN
+#define CSYNC_TEMP_MIN CSYNC_TEMP_CONF_MIN
+#else
+#define CSYNC_TEMP_MIN -10 // degrees C, lower edge of the first bin
+#endif
+
+#ifdef CSYNC_TEMP_CONF_STEP
+#define CSYNC_TEMP_STEP CSYNC_TEMP_CONF_STEP
+#else
+#define CSYNC_TEMP_STEP 2 // degrees C per bin
+#endif
+
+#ifdef CSYNC_TEMP_CONF_BINS
+#define CSYNC_TEMP_BINS CSYNC_TEMP_CONF_BINS
+#else
+#define CSYNC_TEMP_BINS 30
+#endif
+
+/* Learned samples between two writes of the table to flash */
+#ifdef CSYNC_TEMP_CONF_SAVE_EVERY
+#define CSYNC_TEMP_SAVE_EVERY CSYNC_TEMP_CONF_SAVE_EVERY
+#else
+#define CSYNC_TEMP_SAVE_EVERY 32
+#endif
+
+#define CSYNC_TEMP_FILE "csync-temp"
+
+struct csync_temp_bin {
+  int32_t rate;          /// << learned avg_rate in ppb
+  uint16_t weight;       /// << samples learned, 0 if empty
+};
+
+struct csync_temp_stats {
+  int16_t temp;          /// << last reading in 1/100 degree C
+  uint8_t bin;
+  uint16_t learned;
+  uint16_t corrections;
+  int32_t last_correction; /// << ppb
+  uint16_t saved;
+};
+
+/**
+ * Load the table from flash and start sampling. synced is asked
+ * before a sample is learned, csync_all_synced() for C-sync.
+ */
+void csync_temp_open(uint8_t (* synced)(void));
+void csync_temp_close(void);
+
+/**
+ * Predicted avg_rate in ppb at temperature bin, returns 0 if nothing
+ * is learned yet.
+ */
+uint8_t csync_temp_predict(uint8_t bin, int32_t *rate);
+
+/** Forget the table, in RAM and in flash. */
+void csync_temp_clear(void);
+
+const struct csync_temp_stats *csync_temp_get_stats(void);
+void csync_temp_print_stats(void);
+
+#endif /* CSYNC_TEMP_H_ */
@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         FTSP as a sync engine of C-sync
+ *
+ *         The timestamps of an announcement are taken by gtsp_recv(),
+ *         FTSP keeps the last FTSP_MAX_ENTRIES (local time, offset)
+ *         samples of the neighbour it follows and corrects the logical
+ *         clock with a linear regression over them.
+ *
+ *         The announcements carry no root ID, so a node follows its
+ *         neighbour with the lowest address, if that is lower than its
+ *         own. A node without such a neighbour is a root and keeps its
+ *         clock. The samples are offsets measured on the logical clock,
+ *         so the regression gives the residual offset and rate.
+ */
+
+#include "net/c-sync/csync-sync.h"
+
+#define FTSP_ENTRY_EMPTY           0      // Regression table entry is empty
+#define FTSP_ENTRY_FULL            1      // Regression table entry is full
+#define FTSP_ENTRY_VALID_LIMIT     4      // number of entries to become synchronized
+#define FTSP_ENTRY_THROWOUT_LIMIT  1000   // if time sync error is bigger than this clear the table
+#define FTSP_MAX_ENTRIES           8      // number of entries in the regression table
+#define FTSP_MAX_ERRORS            5      // bad readings in a row before the table is cleared
+#define FTSP_SYNC_THRESHOLD        100    // same as GTSP_JUMP_THRESHOLD
+
+#define DEBUG 0
+#if DEBUG
+#include <stdio.h>
+#define PRINTF(...) printf(__VA_ARGS__)
+#else
+#define PRINTF(...)
+#endif
+
+/**
+ *  Regression table entry structure
+ */
+typedef struct ftsp_table_t {
+  uint8_t state;              /// << Indicates if the entries is used or not
+  uint32_t local;             /// << Recorded local time
+  int32_t offset;             /// << Difference of received global time and local time
+} ftsp_table_t;
+
+static ftsp_table_t table[FTSP_MAX_ENTRIES];
+static uint8_t table_entries;
+static uint8_t free_item;
+static uint8_t num_errors;
+static int32_t offset;
+static double skew;
+static uint32_t local_average;
+static uint16_t reference;    /// << address of the neighbour followed, 0 for a root
+
+/*---------------------------------------------------------------------------*/
+static void
+clear_table(void)
+{
+  uint8_t i;
+
+  for(i = 0; i < FTSP_MAX_ENTRIES; i++)
+  {
+    table[i].state = FTSP_ENTRY_EMPTY;
+  }
+  table_entries = 0;
+  free_item = 0;
+}
+/*---------------------------------------------------------------------------*/
+static uint8_t
+table_valid(void)
+{
+  return table_entries >= FTSP_ENTRY_VALID_LIMIT;
+}
+/*---------------------------------------------------------------------------*/
+/* Adds the sample of n, drops the reading if it is too far off */
+static uint8_t
+add_to_regression_table(neighbour_t *n)
+{
+  uint8_t i;
+
+  if(table_valid() &&
+     (n->fine_diff > FTSP_ENTRY_THROWOUT_LIMIT || n->fine_diff < -FTSP_ENTRY_THROWOUT_LIMIT))
+  {
+    if(++num_errors > FTSP_MAX_ERRORS)
+    {
+      clear_table();
+      PRINTF("\n%u FTSP clear", linkaddr_node_addr.u16);
+    }
+    return 0;
+  }
+  num_errors = 0;
+
+  for(i = 0; i < FTSP_MAX_ENTRIES; i++)
+  {
+    if(table[i].state == FTSP_ENTRY_EMPTY)
+    {
+      free_item = i;
+      break;
+    }
+  }
+
+  if(table[free_item].state == FTSP_ENTRY_EMPTY)
+  {
+    table_entries++;
+  }
+  table[free_item].state = FTSP_ENTRY_FULL;
+  table[free_item].local = n->last_hw_my_fine;
+  table[free_item].offset = n->fine_diff;
+  free_item = (free_item + 1) % FTSP_MAX_ENTRIES;
+
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+linear_regression(void)
+{
+  int32_t local_sum = 0, offset_sum = 0;
+  int32_t local_rest = 0, offset_rest = 0;
+  int32_t offset_average;
+  uint8_t i;
+
+  for(i = 0; i < FTSP_MAX_ENTRIES && table[i].state != FTSP_ENTRY_FULL; i++);
+
+  /*
+    We use a rough approximation first to avoid time overflow errors. The idea
+    is that all times in the table should be relatively close to each other.
+  */
+  local_average = table[i].local;
+  offset_average = table[i].offset;
+
+  for(i = 0; i < FTSP_MAX_ENTRIES; i++)
+  {
+    if(table[i].state == FTSP_ENTRY_FULL)
+    {
+      local_sum += (int32_t)(table[i].local - local_average) / table_entries;
+      local_rest += (int32_t)(table[i].local - local_average) % table_entries;
+      offset_sum += (table[i].offset - offset_average) / table_entries;
+      offset_rest += (table[i].offset - offset_average) % table_entries;
+    }
+  }
+
+  local_average += local_sum + local_rest / table_entries;
+  offset_average += offset_sum + offset_rest / table_entries;
+
+  local_sum = offset_sum = 0;
+  for(i = 0; i < FTSP_MAX_ENTRIES; i++)
+  {
+    if(table[i].state == FTSP_ENTRY_FULL)
+    {
+      int32_t a = table[i].local - local_average;
+      int32_t b = table[i].offset - offset_average;
+
+      local_sum += a * a;
+      offset_sum += a * b;
+    }
+  }
+
+  skew = 0;
+  if(local_sum != 0)
+  {
+    skew = (double)offset_sum / (double)local_sum;
+  }
+  offset = offset_average;
+}
+/*---------------------------------------------------------------------------*/
+/* Lowest neighbour address below ours, 0 when this node is a root */
+static uint16_t
+choose_reference(list_t neighbour_list)
+{
+  neighbour_t *n;
+  uint16_t best = 0;
+
+  for(n = list_head(neighbour_list); n != NULL; n = list_item_next(n))
+  {
+    if(n->addr < linkaddr_node_addr.u16 && (best == 0 || n->addr < best))
+    {
+      best = n->addr;
+    }
+  }
+  return best;
+}
+/*---------------------------------------------------------------------------*/
+static void
+init(void)
+{
+  clear_table();
+  num_errors = 0;
+  offset = 0;
+  skew = 0;
+  reference = 0;
+}
+/*---------------------------------------------------------------------------*/
+static void
+update(list_t neighbour_list, neighbour_t *n)
+{
+  uint16_t followed;
+  uint8_t i;
+
+  followed = choose_reference(neighbour_list);
+  if(followed != reference)
+  {
+    PRINTF("\n%u FTSP follows %u", linkaddr_node_addr.u16, followed);
+    reference = followed;
+    clear_table();
+  }
+
+  offset = 0;
+  if(reference != 0 && n->addr == reference && add_to_regression_table(n))
+  {
+    linear_regression();
+
+    /* Keep the residuals of the samples to the regression line
+       offset + skew * (local - local_average), as if the corrected
+       clock had been running all along */
+    for(i = 0; i < FTSP_MAX_ENTRIES; i++)
+    {
+      if(table[i].state == FTSP_ENTRY_FULL)
+      {
+        table[i].offset -= offset + (int32_t)(skew * (int32_t)(table[i].local - local_average));
+      }
+    }
+
+    /* Correct by the line at the newest sample. fine_diff is our clock
+       minus the neighbour's, a positive skew means we run fast. */
+    offset += (int32_t)(skew * (int32_t)(n->last_hw_my_fine - local_average));
+    rtimer_set_avg_rate(RTIMER_AVG_RATE() - skew);
+    rtimer_adjust_fine_offset(offset);
+  }
+
+  for(n = list_head(neighbour_list); n != NULL; n = list_item_next(n))
+  {
+    n->fine_diff -= offset;
+    n->synced = (-FTSP_SYNC_THRESHOLD < n->fine_diff && n->fine_diff < FTSP_SYNC_THRESHOLD);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uint8_t
+synced(list_t neighbour_list)
+{
+  neighbour_t *n;
+
+  if(reference != 0 && !table_valid())
+  {
+    return 0;
+  }
+  for(n = list_head(neighbour_list); n != NULL; n = list_item_next(n))
+  {
+    if(n->synced == 0)
+    {
+      return 0;
+    }
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+const struct csync_sync_driver ftsp_driver = {
+  "ftsp",
+  init,
+  gtsp_recv,
+  update,
+  synced,
+};
+/*---------------------------------------------------------------------------*/
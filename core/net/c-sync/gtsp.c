@@ -1,4 +1,8 @@
 #include "net/c-sync/gtsp.h"
+#include "net/c-sync/csync-sync.h"
+#if CSYNC_HIST
+#include "net/c-sync/csync-hist.h"
+#endif /*CSYNC_HIST*/
 
 
 #define DEBUG 1
@@ -148,6 +152,13 @@ gtsp_recv(neighbour_t *n, timesync_frame_t *syncframe, uint8_t new_neighbour)
     {
         PRINTF("\n%u %lu N %u fd %ld" , linkaddr_node_addr.u16, now_my_fine, n->addr, n->fine_diff);
     }
+
+#if CSYNC_HIST
+    if(!new_neighbour)
+    {
+        csync_hist_sample(n);
+    }
+#endif /*CSYNC_HIST*/
 }
 
 static uint16_t
@@ -314,4 +325,40 @@ gtsp_update_rtimer(list_t neighbour_list)
       n->synced = 0;
     }
   }
-}
\ No newline at end of file
+}
+/*---------------------------------------------------------------------------*/
+static void
+init(void)
+{
+  /* GTSP keeps its state in the neighbour entries */
+}
+/*---------------------------------------------------------------------------*/
+static void
+update(list_t neighbour_list, neighbour_t *n)
+{
+  gtsp_update_rtimer(neighbour_list);
+}
+/*---------------------------------------------------------------------------*/
+static uint8_t
+synced(list_t neighbour_list)
+{
+  struct neighbour *n;
+
+  for(n = list_head(neighbour_list); n != NULL; n = list_item_next(n))
+  {
+    if(n->synced == 0)
+    {
+      return 0;
+    }
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+const struct csync_sync_driver gtsp_driver = {
+  "gtsp",
+  init,
+  gtsp_recv,
+  update,
+  synced,
+};
+/*---------------------------------------------------------------------------*/
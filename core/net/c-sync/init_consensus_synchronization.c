@@ -40,15 +40,16 @@
 
 
 #include "net/c-sync/c-sync.h"
+#include "net/c-sync/csync-coloring.h"
 
 void init_consensus_synchronization(void)
 {
 	struct CHB *ch;
 
-    my_cons_slot = (NUM_CONS_SLOTS + 1) - my_cons_slot;
+    my_cons_slot = (CSYNC_CONS_SLOTS + 1) - my_cons_slot;
     for(ch = list_head(*my_cluster.CHs_list); ch != NULL; ch = list_item_next(ch))
     {
-        ch->cons_slot = (NUM_CONS_SLOTS + 1) - ch->cons_slot;
+        ch->cons_slot = (CSYNC_CONS_SLOTS + 1) - ch->cons_slot;
     }
 
     if(my_cluster.role == CH)
@@ -57,7 +58,7 @@ void init_consensus_synchronization(void)
     }
     else
     {
-        ref_n_CHB_degree = NUM_CONS_SLOTS;
+        ref_n_CHB_degree = CSYNC_CONS_SLOTS;
     }
     ref_n_CHB_addr = my_addr;
     
@@ -75,7 +76,7 @@ void init_consensus_synchronization(void)
             ref_n_CHB_degree = ch->cons_slot;
             my_sync_border = 0;
         }
-        else if(ch->cons_slot > NUM_CONS_SLOTS)
+        else if(ch->cons_slot > CSYNC_CONS_SLOTS)
         {
             my_sync_border = 0;
         }
@@ -1,4 +1,5 @@
 #include "net/c-sync/c-sync.h"
+#include "net/c-sync/csync-coloring.h"
 
 #define DEBUG 1
 #if DEBUG
@@ -105,7 +106,12 @@ received_convergence_announcement(struct announcement *a, const linkaddr_t *from
                   {
                     if(ch->addr == n->addr)
                     {
+#if CSYNC_COLORING
+                      /* The degree is a colour, not the current slot */
+                      if(ch->cons_slot == 0 && a_value->degree != 0)
+#else
                       if(ch->cons_slot == 0 && my_cons_slot == a_value->degree)
+#endif /*CSYNC_COLORING*/
                       {
                         if(!my_slot_ack)
                         {
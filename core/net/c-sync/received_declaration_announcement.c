@@ -1,4 +1,6 @@
 #include "net/c-sync/c-sync.h"
+#include "net/c-sync/csync-phase.h"
+#include "net/c-sync/csync-dedup.h"
 
 
 #define DEBUG 1
@@ -29,6 +31,13 @@ received_declaration_announcement(struct announcement *a, const linkaddr_t *from
     {
       return;
     }
+#if CSYNC_DEDUP
+    /* Copies of a value already handled only feed GTSP */
+    if(csync_dedup_seen(from->u16, id, a_value))
+    {
+      return;
+    }
+#endif /*CSYNC_DEDUP*/
 
     #if MOD_NEIGHBOURS && MOD_TYPE == 5
     if(((my_addr == 65) || (my_addr == 71) || (my_addr == 76)) && ((my_state == ELECTION_DECLARATION) || (my_state == ELECTION_REVELATION)))
@@ -72,7 +81,8 @@ received_declaration_announcement(struct announcement *a, const linkaddr_t *from
           if(a_value->instr == CONNECTION_DECLARATION)
           {
             my_state = CONNECTION_DECLARATION;
-            process_poll(&c_gtsp_process);
+            CSYNC_PHASE_SWITCH(my_state);
+            csync_wake(&c_gtsp_process);
           }
           else if(a_value->instr == ELECTION_DECLARATION)
           {
@@ -191,9 +201,8 @@ received_declaration_announcement(struct announcement *a, const linkaddr_t *from
 
             if(rtimer_schedule(RTIMER_0, RTIMER_DATE, a_value->date_coarse, a_value->date_fine, enter_convergence))
             {
-              rt[RTIMER_0].state = RTIMER_SINGLEPASS;
               list_init(*my_cluster.CHs_list);
-              enter_connection_revelation(rt);
+              enter_connection_late(rt);
             }
           }
         break;
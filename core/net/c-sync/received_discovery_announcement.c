@@ -1,4 +1,6 @@
 #include "net/c-sync/c-sync.h"
+#include "net/c-sync/csync-churn.h"
+#include "net/c-sync/csync-beacon.h"
 
 
 #define DEBUG 1
@@ -36,6 +38,14 @@ received_discovery_announcement(struct announcement *a, const linkaddr_t *from,
         {
             case DISCOVERY:
 
+#if CSYNC_CHURN
+                /* A cluster is already running, join it */
+                if(a_value->instr == IDLE && csync_churn_join(n, a_value))
+                {
+                    break;
+                }
+#endif /*CSYNC_CHURN*/
+
                 if(!csync_all_synced())
                 {
                     //rt[RTIMER_0].state = RTIMER_INACTIVE;
@@ -142,6 +152,12 @@ received_discovery_announcement(struct announcement *a, const linkaddr_t *from,
             break;
 
             case IDLE:
+#if CSYNC_BEACON
+                if(a_value->instr == IDLE)
+                {
+                    csync_beacon_heard(from);
+                }
+#endif /*CSYNC_BEACON*/
             break;
 
             default:
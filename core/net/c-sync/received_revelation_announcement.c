@@ -1,4 +1,6 @@
 #include "net/c-sync/c-sync.h"
+#include "net/c-sync/csync-coloring.h"
+#include "net/c-sync/csync-dedup.h"
 
 #define DEBUG 0
 #if DEBUG
@@ -29,6 +31,13 @@ received_revelation_announcement(struct announcement *a, const linkaddr_t *from,
         {
             return;
         }
+#if CSYNC_DEDUP
+        /* Copies of a value already handled only feed GTSP */
+        if(csync_dedup_seen(from->u16, id, a_value))
+        {
+            return;
+        }
+#endif /*CSYNC_DEDUP*/
         
         if((my_addr == 65) || (my_addr ==71) || (my_addr == 75))
         PRINTF("\n%u: received_revelation_announcement from %u with: instr %u, degree %u, date_coarse %lu, date_fine %lu, ref_addr %u",
@@ -169,7 +178,7 @@ received_revelation_announcement(struct announcement *a, const linkaddr_t *from,
                     }
                   }
 
-                  my_cons_slot = NUM_CONS_SLOTS + 1;
+                  my_cons_slot = CSYNC_CONS_SLOTS + 1;
                   my_slot_ack = 0;
                   enter_consensus_revelation(rt);
                 }
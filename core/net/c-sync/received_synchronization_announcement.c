@@ -1,4 +1,5 @@
 #include "net/c-sync/c-sync.h"
+#include "net/c-sync/csync-churn.h"
 
 #define DEBUG 1
 #if DEBUG
@@ -50,6 +51,10 @@ received_synchronization_announcement(struct announcement *a, const linkaddr_t *
         {
 
             case DISCOVERY: 
+#if CSYNC_CHURN
+              /* Late nodes join from the IDLE beacons, csync_churn_join() */
+              break;
+#endif /*CSYNC_CHURN*/
               my_cluster.role = CM;
               broadcast_announcement_stop();
               announcement_remove_value(&discovery_announcement);
@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         LLSEC driver for the C-sync connection phase
+ */
+
+/**
+ * \addtogroup csyncsec
+ * @{
+ */
+
+#include "net/llsec/csyncsec.h"
+#include "net/netstack.h"
+#include "net/packetbuf.h"
+#include "lib/aes-128.h"
+#include "sys/rtimer.h"
+#include "sys/cc.h"
+#if CSYNCSEC_MIC_LEN
+#include "lib/ccm-star.h"
+#endif /* CSYNCSEC_MIC_LEN */
+
+#include <string.h>
+
+#define DEBUG 0
+#if DEBUG
+#include <stdio.h>
+#define PRINTF(...) printf(__VA_ARGS__)
+#else
+#define PRINTF(...)
+#endif
+
+#define KEYSTREAM_LEN (CSYNCSEC_KEYSTREAM_BLOCKS * AES_128_BLOCK_SIZE)
+#define WORD_MASK (sizeof(unsigned int) - 1)
+
+static uint8_t key[AES_128_KEY_LENGTH] = {
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+  0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F
+};
+
+struct keystream {
+  uint16_t addr_a;        /* lower address of the pair, 0 if unused */
+  uint16_t addr_b;
+  uint16_t last_used;
+  union {
+    unsigned int w[KEYSTREAM_LEN / sizeof(unsigned int)];
+    uint8_t u8[KEYSTREAM_LEN];
+  } ks;
+};
+
+static struct keystream cache[CSYNCSEC_CACHE_SIZE];
+static struct keystream *current;
+static uint16_t use_counter;
+static struct csyncsec_stats stats;
+
+/*---------------------------------------------------------------------------*/
+/*
+ * Block 0 is AES(A * B repeated four times), as the connection phase
+ * always used. Block b counts b into the last byte. The key is set
+ * every time, as CCM* or another user may have changed it.
+ */
+static void
+make_block(const struct keystream *k, uint8_t b, uint8_t *block)
+{
+  uint32_t joined = (uint32_t)k->addr_a * (uint32_t)k->addr_b;
+  uint8_t i;
+
+  for(i = 0; i < AES_128_BLOCK_SIZE; i += 4) {
+    memcpy(&block[i], &joined, 4);
+  }
+  block[AES_128_BLOCK_SIZE - 1] ^= b;
+  AES_128.encrypt(block);
+}
+/*---------------------------------------------------------------------------*/
+static void
+fill_keystream(struct keystream *k)
+{
+  uint8_t b;
+
+  AES_128.set_key(key);
+  for(b = 0; b < CSYNCSEC_KEYSTREAM_BLOCKS; b++) {
+    make_block(k, b, &k->ks.u8[b * AES_128_BLOCK_SIZE]);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static struct keystream *
+get_keystream(uint16_t a, uint16_t b)
+{
+  struct keystream *k, *lru;
+  uint8_t i;
+
+  if(a > b) {
+    uint16_t t = a;
+    a = b;
+    b = t;
+  }
+
+  lru = &cache[0];
+  for(i = 0; i < CSYNCSEC_CACHE_SIZE; i++) {
+    k = &cache[i];
+    if(k->addr_b != 0 && k->addr_a == a && k->addr_b == b) {
+      k->last_used = ++use_counter;
+      stats.hits++;
+      return k;
+    }
+    if(k->addr_b == 0 ||
+       (lru->addr_b != 0 && (uint16_t)(use_counter - k->last_used) >
+        (uint16_t)(use_counter - lru->last_used))) {
+      lru = k;
+    }
+  }
+
+  stats.misses++;
+  lru->addr_a = a;
+  lru->addr_b = b;
+  lru->last_used = ++use_counter;
+  fill_keystream(lru);
+  PRINTF("csyncsec: keystream for %u %u\n", a, b);
+  return lru;
+}
+/*---------------------------------------------------------------------------*/
+/* Word at a time whenever data and keystream share the alignment */
+static void
+xor_chunk(uint8_t *d, const uint8_t *k, uint16_t len)
+{
+  uint16_t i = 0;
+
+  if((((uintptr_t)d ^ (uintptr_t)k) & WORD_MASK) == 0) {
+    for(; i < len && ((uintptr_t)(d + i) & WORD_MASK) != 0; i++) {
+      d[i] ^= k[i];
+    }
+    for(; i + sizeof(unsigned int) <= len; i += sizeof(unsigned int)) {
+      *(unsigned int *)(d + i) ^= *(const unsigned int *)(k + i);
+    }
+  }
+  for(; i < len; i++) {
+    d[i] ^= k[i];
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* The cached blocks cover the first KEYSTREAM_LEN bytes, the block
+   counter goes on for the rest of the frame */
+static void
+xor_keystream(uint8_t *data, uint16_t len)
+{
+  uint8_t block[AES_128_BLOCK_SIZE];
+  uint16_t chunk;
+  uint8_t b;
+
+  chunk = MIN(len, KEYSTREAM_LEN);
+  xor_chunk(data, current->ks.u8, chunk);
+  data += chunk;
+  len -= chunk;
+
+  if(len > 0) {
+    AES_128.set_key(key);
+  }
+  for(b = CSYNCSEC_KEYSTREAM_BLOCKS; len > 0; b++) {
+    make_block(current, b, block);
+    chunk = MIN(len, AES_128_BLOCK_SIZE);
+    xor_chunk(data, block, chunk);
+    data += chunk;
+    len -= chunk;
+  }
+}
+/*---------------------------------------------------------------------------*/
+#if CSYNCSEC_MIC_LEN
+/* The timesync trailer makes every frame of a sender unique */
+static void
+set_nonce(uint8_t *nonce, const linkaddr_t *sender, const uint8_t *trailer)
+{
+  timesync_frame_t sf;
+
+  memcpy(&sf, trailer, sizeof(timesync_frame_t));
+  memset(nonce, 0, CCM_STAR_NONCE_LENGTH);
+  memcpy(nonce, sender->u8, MIN(LINKADDR_SIZE, 2));
+  memcpy(nonce + 2, &sf.coarse_now, 4);
+  memcpy(nonce + 6, &sf.fine_offset, 4);
+  memcpy(nonce + 10, &sf.tb, 2);
+  nonce[12] = sf.ta & 0xff;
+}
+#endif /* CSYNCSEC_MIC_LEN */
+/*---------------------------------------------------------------------------*/
+void
+csyncsec_set_key(const uint8_t *new_key)
+{
+  uint16_t a = 0;
+  uint16_t b = 0;
+  uint8_t i;
+
+  if(current != NULL) {
+    a = current->addr_a;
+    b = current->addr_b;
+  }
+  memcpy(key, new_key, AES_128_KEY_LENGTH);
+  /* The cached keystreams belong to the old key */
+  for(i = 0; i < CSYNCSEC_CACHE_SIZE; i++) {
+    cache[i].addr_b = 0;
+  }
+  current = b != 0 ? get_keystream(a, b) : NULL;
+}
+/*---------------------------------------------------------------------------*/
+static void
+init(void)
+{
+  if(packetbuf_attr(PACKETBUF_ATTR_CSYNC_CONN_DOAES)) {
+    current = get_keystream(packetbuf_attr(PACKETBUF_ATTR_CSYNC_CONN_AES_XORPLAINTEXT_A),
+                            packetbuf_attr(PACKETBUF_ATTR_CSYNC_CONN_AES_XORPLAINTEXT_B));
+  } else {
+    current = NULL;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+send(mac_callback_t sent, void *ptr)
+{
+  uint8_t *frame;
+  uint16_t len;
+#if CSYNCSEC_MIC_LEN
+  uint8_t nonce[CCM_STAR_NONCE_LENGTH];
+#endif /* CSYNCSEC_MIC_LEN */
+
+  len = packetbuf_totlen();
+  if(current != NULL && len >= sizeof(timesync_frame_t)) {
+    frame = packetbuf_hdrptr();
+    len -= sizeof(timesync_frame_t);
+#if CSYNCSEC_MIC_LEN
+    if(packetbuf_totlen() + CSYNCSEC_MIC_LEN > PACKETBUF_SIZE) {
+      /* The receiver always expects a MIC */
+      PRINTF("csyncsec: no room for the MIC\n");
+      mac_call_sent_callback(sent, ptr, MAC_TX_ERR_FATAL, 0);
+      return;
+    }
+#endif /* CSYNCSEC_MIC_LEN */
+    xor_keystream(frame, len);
+#if CSYNCSEC_MIC_LEN
+    /* The MIC goes in front of the timesync trailer: the radio writes
+       the SFD timestamp into the last two bytes of the frame */
+    memmove(frame + len + CSYNCSEC_MIC_LEN, frame + len, sizeof(timesync_frame_t));
+    packetbuf_set_datalen(packetbuf_datalen() + CSYNCSEC_MIC_LEN);
+    set_nonce(nonce, &linkaddr_node_addr, frame + len + CSYNCSEC_MIC_LEN);
+    AES_128.set_key(key);
+    CCM_STAR.aead(nonce, NULL, 0, frame, len, frame + len, CSYNCSEC_MIC_LEN, 1);
+#endif /* CSYNCSEC_MIC_LEN */
+  }
+
+  NETSTACK_MAC.send(sent, ptr);
+}
+/*---------------------------------------------------------------------------*/
+static void
+input(void)
+{
+  uint8_t *data;
+  uint16_t len;
+#if CSYNCSEC_MIC_LEN
+  uint8_t nonce[CCM_STAR_NONCE_LENGTH];
+  uint8_t mic[CSYNCSEC_MIC_LEN];
+#endif /* CSYNCSEC_MIC_LEN */
+
+  if(current != NULL) {
+    data = packetbuf_dataptr();
+    len = packetbuf_datalen();
+#if CSYNCSEC_MIC_LEN
+    if(len < sizeof(timesync_frame_t) + CSYNCSEC_MIC_LEN) {
+      return;
+    }
+    /* Payload, MIC, then the timesync trailer */
+    len -= sizeof(timesync_frame_t) + CSYNCSEC_MIC_LEN;
+    set_nonce(nonce, packetbuf_addr(PACKETBUF_ADDR_SENDER), data + len + CSYNCSEC_MIC_LEN);
+    AES_128.set_key(key);
+    CCM_STAR.aead(nonce, NULL, 0, data, len, mic, CSYNCSEC_MIC_LEN, 0);
+    if(memcmp(mic, data + len, CSYNCSEC_MIC_LEN) != 0) {
+      stats.mic_failures++;
+      PRINTF("csyncsec: MIC mismatch from %u\n", packetbuf_addr(PACKETBUF_ADDR_SENDER)->u16);
+      return;
+    }
+    memmove(data + len, data + len + CSYNCSEC_MIC_LEN, sizeof(timesync_frame_t));
+    packetbuf_set_datalen(packetbuf_datalen() - CSYNCSEC_MIC_LEN);
+    xor_keystream(data, len);
+#else /* CSYNCSEC_MIC_LEN */
+    if(len >= sizeof(timesync_frame_t)) {
+      xor_keystream(data, len - sizeof(timesync_frame_t));
+    }
+#endif /* CSYNCSEC_MIC_LEN */
+  }
+
+  NETSTACK_NETWORK.input();
+}
+/*---------------------------------------------------------------------------*/
+const struct csyncsec_stats *
+csyncsec_get_stats(void)
+{
+  return &stats;
+}
+/*---------------------------------------------------------------------------*/
+const struct llsec_driver csyncsec_driver = {
+  "csyncsec",
+  init,
+  send,
+  input
+};
+/*---------------------------------------------------------------------------*/
+
+/** @} */
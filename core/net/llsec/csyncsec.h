@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \addtogroup llsec
+ * @{
+ */
+
+/**
+ * \defgroup csyncsec LLSEC driver for the C-sync connection phase
+ *
+ * While a CB announces its connection between two CHs, C-sync sets
+ * PACKETBUF_ATTR_CSYNC_CONN_DOAES with the two CH addresses and calls
+ * NETSTACK_LLSEC.init(). The frames are then XORed with an AES-CTR
+ * keystream derived from the pair, up to the timesync trailer.
+ *
+ * The keystream of the last CSYNCSEC_CACHE_SIZE pairs is kept, so
+ * switching back to a known pair costs no AES operation. With
+ * CSYNCSEC_CONF_MIC_LEN > 0 every protected frame also carries a
+ * CCM* MIC over the obfuscated frame, placed in front of the timesync
+ * trailer since the radio overwrites the last two bytes of the frame
+ * with the SFD timestamp. Frames with no room for the MIC are not sent.
+ *
+ * @{
+ */
+
+#ifndef CSYNCSEC_H_
+#define CSYNCSEC_H_
+
+#include "net/llsec/llsec.h"
+
+#ifdef CSYNCSEC_CONF_KEYSTREAM_BLOCKS
+#define CSYNCSEC_KEYSTREAM_BLOCKS CSYNCSEC_CONF_KEYSTREAM_BLOCKS
+#else
+#define CSYNCSEC_KEYSTREAM_BLOCKS 4 // cached, longer frames cost an AES block per 16 bytes
+#endif
+
+#ifdef CSYNCSEC_CONF_CACHE_SIZE
+#define CSYNCSEC_CACHE_SIZE CSYNCSEC_CONF_CACHE_SIZE
+#else
+#define CSYNCSEC_CACHE_SIZE 3
+#endif
+
+#ifdef CSYNCSEC_CONF_MIC_LEN
+#define CSYNCSEC_MIC_LEN CSYNCSEC_CONF_MIC_LEN
+#else
+#define CSYNCSEC_MIC_LEN 0
+#endif
+
+struct csyncsec_stats {
+  uint16_t hits;
+  uint16_t misses;
+  uint16_t mic_failures;
+};
+
+extern const struct llsec_driver csyncsec_driver;
+
+const struct csyncsec_stats *csyncsec_get_stats(void);
+
+/**
+ * Replace the AES key. The cached keystreams are dropped and the
+ * keystream of the current pair is derived again with the new key.
+ */
+void csyncsec_set_key(const uint8_t *new_key);
+
+#endif /* CSYNCSEC_H_ */
+
+/** @} */
+/** @} */
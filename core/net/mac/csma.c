@@ -48,7 +48,7 @@
 
 #include "net/netstack.h"
 
-#include "lib/list.h"
+#include "lib/dlist.h"
 #include "lib/memb.h"
 
 #include <string.h>
@@ -103,11 +103,12 @@ struct qbuf_metadata {
 /* Every neighbor has its own packet queue */
 struct neighbor_queue {
   struct neighbor_queue *next;
+  struct neighbor_queue *prev;
   linkaddr_t addr;
   struct ctimer transmit_timer;
   uint8_t transmissions;
   uint8_t collisions;
-  LIST_STRUCT(queued_packet_list);
+  DLIST_STRUCT(queued_packet_list);
 };
 
 /* The maximum number of co-existing neighbor queues */
@@ -128,7 +129,7 @@ struct neighbor_queue {
 MEMB(neighbor_memb, struct neighbor_queue, CSMA_MAX_NEIGHBOR_QUEUES);
 MEMB(packet_memb, struct rdc_buf_list, MAX_QUEUED_PACKETS);
 MEMB(metadata_memb, struct qbuf_metadata, MAX_QUEUED_PACKETS);
-LIST(neighbor_list);
+DLIST(neighbor_list);
 
 static void packet_sent(void *ptr, int status, int num_transmissions);
 static void transmit_packet_list(void *ptr);
@@ -136,12 +137,12 @@ static void transmit_packet_list(void *ptr);
 static struct neighbor_queue *
 neighbor_queue_from_addr(const linkaddr_t *addr)
 {
-  struct neighbor_queue *n = list_head(neighbor_list);
+  struct neighbor_queue *n = dlist_head(neighbor_list);
   while(n != NULL) {
     if(linkaddr_cmp(&n->addr, addr)) {
       return n;
     }
-    n = list_item_next(n);
+    n = dlist_item_next(n);
   }
   return NULL;
 }
@@ -152,10 +153,10 @@ transmit_packet_list(void *ptr)
 {
   struct neighbor_queue *n = ptr;
   if(n) {
-    struct rdc_buf_list *q = list_head(n->queued_packet_list);
+    struct rdc_buf_list *q = dlist_head(n->queued_packet_list);
     if(q != NULL) {
       PRINTF("csma: preparing number %d %p, queue len %d\n", n->transmissions, q,
-          list_length(n->queued_packet_list));
+          dlist_length(n->queued_packet_list));
       /* Send packets in the neighbor's list */
       NETSTACK_RDC.send_list(packet_sent, n, q);
     }
@@ -187,14 +188,14 @@ free_packet(struct neighbor_queue *n, struct rdc_buf_list *p, int status)
 {
   if(p != NULL) {
     /* Remove packet from list and deallocate */
-    list_remove(n->queued_packet_list, p);
+    dlist_remove(n->queued_packet_list, p);
 
     queuebuf_free(p->buf);
     memb_free(&metadata_memb, p->ptr);
     memb_free(&packet_memb, p);
     PRINTF("csma: free_queued_packet, queue length %d, free packets %d\n",
-           list_length(n->queued_packet_list), memb_numfree(&packet_memb));
-    if(list_head(n->queued_packet_list) != NULL) {
+           dlist_length(n->queued_packet_list), memb_numfree(&packet_memb));
+    if(dlist_head(n->queued_packet_list) != NULL) {
       /* There is a next packet. We reset current tx information */
       n->transmissions = 0;
       n->collisions = CSMA_MIN_BE;
@@ -203,7 +204,7 @@ free_packet(struct neighbor_queue *n, struct rdc_buf_list *p, int status)
     } else {
       /* This was the last packet in the queue, we free the neighbor */
       ctimer_stop(&n->transmit_timer);
-      list_remove(neighbor_list, n);
+      dlist_remove(neighbor_list, n);
       memb_free(&neighbor_memb, n);
     }
   }
@@ -311,8 +312,8 @@ packet_sent(void *ptr, int status, int num_transmissions)
   }
 
   /* Find out what packet this callback refers to */
-  for(q = list_head(n->queued_packet_list);
-      q != NULL; q = list_item_next(q)) {
+  for(q = dlist_head(n->queued_packet_list);
+      q != NULL; q = dlist_item_next(q)) {
     if(queuebuf_attr(q->buf, PACKETBUF_ATTR_MAC_SEQNO) ==
        packetbuf_attr(PACKETBUF_ATTR_MAC_SEQNO)) {
       break;
@@ -379,15 +380,15 @@ send_packet(mac_callback_t sent, void *ptr)
       n->transmissions = 0;
       n->collisions = CSMA_MIN_BE;
       /* Init packet list for this neighbor */
-      LIST_STRUCT_INIT(n, queued_packet_list);
+      DLIST_STRUCT_INIT(n, queued_packet_list);
       /* Add neighbor to the list */
-      list_add(neighbor_list, n);
+      dlist_add(neighbor_list, n);
     }
   }
 
   if(n != NULL) {
     /* Add packet to the neighbor's queue */
-    if(list_length(n->queued_packet_list) < CSMA_MAX_PACKET_PER_NEIGHBOR) {
+    if(dlist_length(n->queued_packet_list) < CSMA_MAX_PACKET_PER_NEIGHBOR) {
       q = memb_alloc(&packet_memb);
       if(q != NULL) {
         q->ptr = memb_alloc(&metadata_memb);
@@ -408,17 +409,17 @@ send_packet(mac_callback_t sent, void *ptr)
 #if PACKETBUF_WITH_PACKET_TYPE
             if(packetbuf_attr(PACKETBUF_ATTR_PACKET_TYPE) ==
                PACKETBUF_ATTR_PACKET_TYPE_ACK) {
-              list_push(n->queued_packet_list, q);
+              dlist_push(n->queued_packet_list, q);
             } else
 #endif
             {
-              list_add(n->queued_packet_list, q);
+              dlist_add(n->queued_packet_list, q);
             }
 
             PRINTF("csma: send_packet, queue length %d, free packets %d\n",
-                   list_length(n->queued_packet_list), memb_numfree(&packet_memb));
+                   dlist_length(n->queued_packet_list), memb_numfree(&packet_memb));
             /* If q is the first packet in the neighbor's queue, send asap */
-            if(list_head(n->queued_packet_list) == q) {
+            if(dlist_head(n->queued_packet_list) == q) {
               schedule_transmission(n);
             }
             return;
@@ -430,8 +431,8 @@ send_packet(mac_callback_t sent, void *ptr)
         PRINTF("csma: could not allocate queuebuf, dropping packet\n");
       }
       /* The packet allocation failed. Remove and free neighbor entry if empty. */
-      if(list_length(n->queued_packet_list) == 0) {
-        list_remove(neighbor_list, n);
+      if(dlist_length(n->queued_packet_list) == 0) {
+        dlist_remove(neighbor_list, n);
         memb_free(&neighbor_memb, n);
       }
     } else {
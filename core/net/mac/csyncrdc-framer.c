@@ -111,7 +111,7 @@ send_list(mac_callback_t sent, void *ptr, struct rdc_buf_list *buf_list)
     struct rdc_buf_list *next = buf_list->next;
     int last_sent_ok;
 
-    queuebuf_to_packetbuf(buf_list->buf);
+    queuebuf_to_packetbuf_view(buf_list->buf);
     last_sent_ok = send_one_packet(sent, ptr);
 
     /* If packet transmission was not successful, we should back off and let
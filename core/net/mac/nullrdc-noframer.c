@@ -60,7 +60,7 @@ static void
 send_list(mac_callback_t sent, void *ptr, struct rdc_buf_list *buf_list)
 {
   if(buf_list != NULL) {
-    queuebuf_to_packetbuf(buf_list->buf);
+    queuebuf_to_packetbuf_view(buf_list->buf);
     send_packet(sent, ptr);
   }
 }
@@ -55,9 +55,10 @@
 #define RDC_WITH_DUPLICATE_DETECTION !LLSEC802154_ENABLED
 #endif /* RDC_CONF_WITH_DUPLICATE_DETECTION */
 
-/* List of packets to be sent by RDC layer */
+/* List of packets to be sent by RDC layer, a dlist in csma */
 struct rdc_buf_list {
   struct rdc_buf_list *next;
+  struct rdc_buf_list *prev;
   struct queuebuf *buf;
   void *ptr;
 };
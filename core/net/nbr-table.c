@@ -83,6 +83,17 @@ static unsigned num_tables;
 MEMB(neighbor_addr_mem, nbr_table_key_t, NBR_TABLE_MAX_NEIGHBORS);
 LIST(nbr_table_keys);
 
+/* Open-addressing hash from link-layer address to neighbor index, with
+ * linear probing. A slot holds the neighbor index plus one, 0 is empty.
+ * It contains exactly the keys that are in nbr_table_keys. */
+#if NBR_TABLE_MAX_NEIGHBORS < 255
+typedef uint8_t nbr_table_slot_t;
+#else
+typedef uint16_t nbr_table_slot_t;
+#endif
+#define HASH_MASK (NBR_TABLE_HASH_SIZE - 1)
+static nbr_table_slot_t hash_slots[NBR_TABLE_HASH_SIZE];
+
 /*---------------------------------------------------------------------------*/
 /* Get a key from a neighbor index */
 static nbr_table_key_t *
@@ -126,22 +137,82 @@ key_from_item(nbr_table_t *table, const nbr_table_item_t *item)
   return key_from_index(index_from_item(table, item));
 }
 /*---------------------------------------------------------------------------*/
+/* Home slot of a link-layer address in the hash */
+static unsigned
+hash_lladdr(const linkaddr_t *lladdr)
+{
+  unsigned h = 0;
+  int i;
+  for(i = 0; i < LINKADDR_SIZE; i++) {
+    h = (h << 3) + (h >> 5) + lladdr->u8[i];
+  }
+  return (h ^ (h >> 7)) & HASH_MASK;
+}
+/*---------------------------------------------------------------------------*/
+/* Add a key to the hash, its link-layer address must be set */
+static void
+hash_insert(nbr_table_key_t *key)
+{
+  unsigned slot = hash_lladdr(&key->lladdr);
+  while(hash_slots[slot] != 0) {
+    slot = (slot + 1) & HASH_MASK;
+  }
+  hash_slots[slot] = index_from_key(key) + 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Remove a key from the hash, before its link-layer address changes.
+ * The entries that follow in the probe sequence are shifted back into
+ * the hole, so that no tombstones are needed. */
+static void
+hash_remove(nbr_table_key_t *key)
+{
+  nbr_table_slot_t value = index_from_key(key) + 1;
+  unsigned hole = hash_lladdr(&key->lladdr);
+  unsigned slot;
+  unsigned home;
+
+  while(hash_slots[hole] != value) {
+    if(hash_slots[hole] == 0) {
+      return;
+    }
+    hole = (hole + 1) & HASH_MASK;
+  }
+  hash_slots[hole] = 0;
+
+  slot = hole;
+  for(;;) {
+    slot = (slot + 1) & HASH_MASK;
+    if(hash_slots[slot] == 0) {
+      return;
+    }
+    home = hash_lladdr(&key_from_index(hash_slots[slot] - 1)->lladdr);
+    /* Move the entry unless its home lies cyclically in (hole, slot] */
+    if(((slot - home) & HASH_MASK) >= ((slot - hole) & HASH_MASK)) {
+      hash_slots[hole] = hash_slots[slot];
+      hash_slots[slot] = 0;
+      hole = slot;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
 /* Get the index of a neighbor from its link-layer address */
 static int
 index_from_lladdr(const linkaddr_t *lladdr)
 {
   nbr_table_key_t *key;
+  unsigned slot;
   /* Allow lladdr-free insertion, useful e.g. for IPv6 ND.
    * Only one such entry is possible at a time, indexed by linkaddr_null. */
   if(lladdr == NULL) {
     lladdr = &linkaddr_null;
   }
-  key = list_head(nbr_table_keys);
-  while(key != NULL) {
-    if(lladdr && linkaddr_cmp(lladdr, &key->lladdr)) {
-      return index_from_key(key);
+  slot = hash_lladdr(lladdr);
+  while(hash_slots[slot] != 0) {
+    key = key_from_index(hash_slots[slot] - 1);
+    if(linkaddr_cmp(lladdr, &key->lladdr)) {
+      return hash_slots[slot] - 1;
     }
-    key = list_item_next(key);
+    slot = (slot + 1) & HASH_MASK;
   }
   return -1;
 }
@@ -193,7 +264,8 @@ remove_key(nbr_table_key_t *least_used_key)
   }
   /* Empty used map */
   used_map[index_from_key(least_used_key)] = 0;
-  /* Remove neighbor from list */
+  /* Remove neighbor from hash and list */
+  hash_remove(least_used_key);
   list_remove(nbr_table_keys, least_used_key);
 }
 /*---------------------------------------------------------------------------*/
@@ -359,6 +431,7 @@ nbr_table_add_lladdr(nbr_table_t *table, const linkaddr_t *lladdr, nbr_table_rea
 
     /* Set link-layer address */
     linkaddr_copy(&key->lladdr, lladdr);
+    hash_insert(key);
   }
 
   /* Get item in the current table */
@@ -448,9 +521,11 @@ nbr_table_update_lladdr(const linkaddr_t *old_addr, const linkaddr_t *new_addr,
   key = key_from_index(index);
   /**
    * Copy the new lladdr into the key - since we know that there is no
-   * conflicting entry.
+   * conflicting entry. The key is rehashed under its new address.
    */
+  hash_remove(key);
   memcpy(&key->lladdr, new_addr, sizeof(linkaddr_t));
+  hash_insert(key);
   return 1;
 }
 /*---------------------------------------------------------------------------*/
@@ -46,6 +46,32 @@
 #define NBR_TABLE_MAX_NEIGHBORS 8
 #endif /* NBR_TABLE_CONF_MAX_NEIGHBORS */
 
+/* Number of slots of the link-layer address hash, a power of two.
+ * Kept at least twice the table size so that probe sequences stay short. */
+#ifdef NBR_TABLE_CONF_HASH_SIZE
+#define NBR_TABLE_HASH_SIZE NBR_TABLE_CONF_HASH_SIZE
+#elif NBR_TABLE_MAX_NEIGHBORS <= 8
+#define NBR_TABLE_HASH_SIZE 16
+#elif NBR_TABLE_MAX_NEIGHBORS <= 16
+#define NBR_TABLE_HASH_SIZE 32
+#elif NBR_TABLE_MAX_NEIGHBORS <= 32
+#define NBR_TABLE_HASH_SIZE 64
+#elif NBR_TABLE_MAX_NEIGHBORS <= 64
+#define NBR_TABLE_HASH_SIZE 128
+#elif NBR_TABLE_MAX_NEIGHBORS <= 128
+#define NBR_TABLE_HASH_SIZE 256
+#else
+#define NBR_TABLE_HASH_SIZE 512
+#endif /* NBR_TABLE_CONF_HASH_SIZE */
+
+/* Probing only ends on an empty slot and wraps with a mask */
+#if (NBR_TABLE_HASH_SIZE & (NBR_TABLE_HASH_SIZE - 1)) != 0
+#error "NBR_TABLE_HASH_SIZE must be a power of two"
+#endif
+#if NBR_TABLE_HASH_SIZE <= NBR_TABLE_MAX_NEIGHBORS
+#error "NBR_TABLE_HASH_SIZE must be larger than NBR_TABLE_MAX_NEIGHBORS"
+#endif
+
 /* An item in a neighbor table */
 typedef void nbr_table_item_t;
 
@@ -46,6 +46,7 @@
 
 #include "contiki-net.h"
 #include "net/packetbuf.h"
+#include "net/queuebuf.h"
 #include "net/rime/rime.h"
 #include "sys/cc.h"
 
@@ -63,6 +64,11 @@ static uint8_t hdrlen;
 static uint32_t packetbuf_aligned[(PACKETBUF_SIZE + 3) / 4];
 static uint8_t *packetbuf = (uint8_t *)packetbuf_aligned;
 
+/* When the packetbuf is a view of a queued frame, the queue buffer that
+   holds the frame and the number of free bytes in front of packetbuf */
+static void *view;
+static uint8_t headroom;
+
 #define DEBUG 0
 #if DEBUG
 #include <stdio.h>
@@ -71,10 +77,41 @@ static uint8_t *packetbuf = (uint8_t *)packetbuf_aligned;
 #define PRINTF(...)
 #endif
 
+/*---------------------------------------------------------------------------*/
+static void
+view_release(void)
+{
+  if(view != NULL) {
+    queuebuf_release_view(view);
+    view = NULL;
+    headroom = 0;
+    packetbuf = (uint8_t *)packetbuf_aligned;
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+packetbuf_detach(void)
+{
+  if(view != NULL) {
+    memcpy(packetbuf_aligned, packetbuf, packetbuf_totlen());
+    view_release();
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+packetbuf_set_view(void *owner, uint8_t *frame, uint16_t len, uint8_t room)
+{
+  packetbuf_clear();
+  packetbuf = frame;
+  buflen = len;
+  headroom = room;
+  view = owner;
+}
 /*---------------------------------------------------------------------------*/
 void
 packetbuf_clear(void)
 {
+  view_release();
   buflen = bufptr = 0;
   hdrlen = 0;
 
@@ -99,6 +136,7 @@ packetbuf_compact(void)
   int16_t i;
 
   if(bufptr) {
+    packetbuf_detach();
     /* shift data to the left */
     for(i = 0; i < buflen; i++) {
       packetbuf[hdrlen + i] = packetbuf[packetbuf_hdrlen() + i];
@@ -127,6 +165,15 @@ packetbuf_hdralloc(int size)
     return 0;
   }
 
+  if(size <= headroom) {
+    /* The header goes in front of the viewed frame, which is left as is */
+    packetbuf -= size;
+    headroom -= size;
+    hdrlen += size;
+    return 1;
+  }
+  packetbuf_detach();
+
   /* shift data to the right */
   for(i = packetbuf_totlen() - 1; i >= 0; i--) {
     packetbuf[i + size] = packetbuf[i];
@@ -151,6 +198,7 @@ void
 packetbuf_set_datalen(uint16_t len)
 {
   PRINTF("packetbuf_set_len: len %d\n", len);
+  packetbuf_detach();
   buflen = len;
 }
 /*---------------------------------------------------------------------------*/
@@ -211,6 +211,40 @@ int packetbuf_hdralloc(int size);
  */
 int packetbuf_hdrreduce(int size);
 
+/**
+ * \brief      Make the packetbuf a view of a queued frame
+ * \param owner The queue buffer that holds the frame
+ * \param frame A pointer to the frame
+ * \param len  The length of the frame
+ * \param room The number of free bytes in front of the frame
+ *
+ *             This function is used by queuebuf_to_packetbuf_view()
+ *             to let the packetbuf use a queued frame in place instead
+ *             of copying it. Headers allocated with
+ *             packetbuf_hdralloc() go in the room in front of the
+ *             frame, so the frame itself is not modified and can be
+ *             sent again. The packetbuf holds a reference on the queue
+ *             buffer until it is cleared.
+ *
+ */
+void packetbuf_set_view(void *owner, uint8_t *frame, uint16_t len, uint8_t room);
+
+/**
+ * \brief      Give the packetbuf its own copy of a viewed frame
+ *
+ *             This function copies a frame that the packetbuf views
+ *             into the packetbuf and releases the queue buffer. It
+ *             must be called before the data of a viewed frame is
+ *             modified in place through packetbuf_dataptr() or
+ *             packetbuf_hdrptr(). packetbuf_compact(),
+ *             packetbuf_set_datalen() and packetbuf_hdralloc(), when
+ *             the room in front of the frame is too small, call it
+ *             themselves. It does nothing if the packetbuf is not a
+ *             view.
+ *
+ */
+void packetbuf_detach(void);
+
 /* Packet attributes stuff below: */
 
 typedef uint16_t packetbuf_attr_t;
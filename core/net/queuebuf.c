@@ -70,10 +70,16 @@ struct queuebuf {
 #endif
 };
 
-/* The actual queuebuf data */
+/* The actual queuebuf data. It is shared by the queuebuf and the
+   packetbuf while the packetbuf views it, and freed with the last
+   reference. */
 struct queuebuf_data {
+#if QUEUEBUF_HDR_SIZE > 0
+  uint8_t hdr[QUEUEBUF_HDR_SIZE];
+#endif
   uint8_t data[PACKETBUF_SIZE];
   uint16_t len;
+  uint8_t refs;
   struct packetbuf_attr attrs[PACKETBUF_NUM_ATTRS];
   struct packetbuf_addr addrs[PACKETBUF_NUM_ADDRS];
 };
@@ -276,6 +282,14 @@ queuebuf_load_to_ram(struct queuebuf *b)
 }
 #endif /* WITH_SWAP */
 /*---------------------------------------------------------------------------*/
+static void
+data_release(struct queuebuf_data *d)
+{
+  if(--d->refs == 0) {
+    memb_free(&buframmem, d);
+  }
+}
+/*---------------------------------------------------------------------------*/
 void
 queuebuf_init(void)
 {
@@ -319,6 +333,11 @@ queuebuf_new_from_packetbuf(void)
     buf->time = clock_time();
 #endif /* QUEUEBUF_DEBUG */
     buf->ram_ptr = memb_alloc(&buframmem);
+    if(buf->ram_ptr == NULL) {
+      /* The packetbuf may hold the last reference on a queued frame */
+      packetbuf_detach();
+      buf->ram_ptr = memb_alloc(&buframmem);
+    }
 #if WITH_SWAP
     /* If the allocation failed, store the qbuf in swap files */
     if(buf->ram_ptr != NULL) {
@@ -340,6 +359,7 @@ queuebuf_new_from_packetbuf(void)
 #endif
 
     buframptr->len = packetbuf_copyto(buframptr->data);
+    buframptr->refs = 1;
     packetbuf_attr_copyto(buframptr->attrs, buframptr->addrs);
 
 #if WITH_SWAP
@@ -382,6 +402,8 @@ void
 queuebuf_update_from_packetbuf(struct queuebuf *buf)
 {
   struct queuebuf_data *buframptr = queuebuf_load_to_ram(buf);
+  /* Do not copy the packetbuf onto the frame it views */
+  packetbuf_detach();
   packetbuf_attr_copyto(buframptr->attrs, buframptr->addrs);
   buframptr->len = packetbuf_copyto(buframptr->data);
 #if WITH_SWAP
@@ -397,12 +419,12 @@ queuebuf_free(struct queuebuf *buf)
   if(memb_inmemb(&bufmem, buf)) {
 #if WITH_SWAP
     if(buf->location == IN_RAM) {
-      memb_free(&buframmem, buf->ram_ptr);
+      data_release(buf->ram_ptr);
     } else {
       queuebuf_remove_from_file(buf->swap_id);
     }
 #else
-    memb_free(&buframmem, buf->ram_ptr);
+    data_release(buf->ram_ptr);
 #endif
     memb_free(&bufmem, buf);
 #if QUEUEBUF_STATS
@@ -425,6 +447,34 @@ queuebuf_to_packetbuf(struct queuebuf *b)
   }
 }
 /*---------------------------------------------------------------------------*/
+/* Like queuebuf_to_packetbuf(), but the packetbuf uses the queued frame
+   in place. Only the attributes are copied. The queuebuf may be freed
+   while the packetbuf still views the frame. */
+void
+queuebuf_to_packetbuf_view(struct queuebuf *b)
+{
+  if(memb_inmemb(&bufmem, b)) {
+    struct queuebuf_data *buframptr;
+#if WITH_SWAP
+    if(b->location == IN_CFS) {
+      queuebuf_to_packetbuf(b);
+      return;
+    }
+#endif
+    buframptr = b->ram_ptr;
+    buframptr->refs++;
+    packetbuf_set_view(buframptr, buframptr->data, buframptr->len,
+                       QUEUEBUF_HDR_SIZE);
+    packetbuf_attr_copyfrom(buframptr->attrs, buframptr->addrs);
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+queuebuf_release_view(void *frame)
+{
+  data_release(frame);
+}
+/*---------------------------------------------------------------------------*/
 void *
 queuebuf_dataptr(struct queuebuf *b)
 {
@@ -79,6 +79,16 @@
   #define WITH_SWAP 0
 #endif /* QUEUEBUFRAM_CONF_NUM */
 
+/* QUEUEBUF_HDR_SIZE is the room kept in front of every queued frame,
+   a multiple of 4. It lets a lower layer add its header to a frame
+   viewed with queuebuf_to_packetbuf_view() without copying the frame.
+   It should fit the header of NETSTACK_FRAMER. */
+#ifdef QUEUEBUF_CONF_HDR_SIZE
+#define QUEUEBUF_HDR_SIZE QUEUEBUF_CONF_HDR_SIZE
+#else
+#define QUEUEBUF_HDR_SIZE 0
+#endif
+
 #ifdef QUEUEBUF_CONF_DEBUG
 #define QUEUEBUF_DEBUG QUEUEBUF_CONF_DEBUG
 #else /* QUEUEBUF_CONF_DEBUG */
@@ -99,6 +109,8 @@ void queuebuf_update_attr_from_packetbuf(struct queuebuf *b);
 void queuebuf_update_from_packetbuf(struct queuebuf *b);
 
 void queuebuf_to_packetbuf(struct queuebuf *b);
+void queuebuf_to_packetbuf_view(struct queuebuf *b);
+void queuebuf_release_view(void *frame);
 void queuebuf_free(struct queuebuf *b);
 
 void *queuebuf_dataptr(struct queuebuf *b);
@@ -48,6 +48,8 @@
 
 LIST(announcements);
 
+struct announcement_counters announcement_counters;
+
 static announcement_observer observer_callback;
 
 /*---------------------------------------------------------------------------*/
@@ -125,6 +125,15 @@ void announcement_heard(const linkaddr_t *from, uint16_t id, struct announcement
 
 struct announcement *announcement_list(void);
 
+/* Number of announcement packets sent and received by the polite and
+   broadcast announcement modules. Only ever incremented, users take
+   deltas. */
+struct announcement_counters {
+  uint32_t sent;
+  uint32_t received;
+};
+extern struct announcement_counters announcement_counters;
+
 void announcement_set_instr(struct announcement *a, uint8_t instr);
 uint8_t announcement_get_instr(struct announcement *a);
 void announcement_set_degree(struct announcement *a, uint8_t degree);
@@ -81,6 +81,7 @@ static struct broadcast_announcement_state {
   struct broadcast_conn c;
   struct ctimer send_timer, interval_timer;
   clock_time_t current_interval, min_interval, max_interval;
+  uint8_t slotted;
 } c;
 
 
@@ -154,6 +155,7 @@ adv_packet_received(struct broadcast_conn *ibc, const linkaddr_t *from)
     //PRINTF("adata.num way out there: %d\n", adata.num);
     return;
   }
+  announcement_counters.received++;
 
   ptr += ANNOUNCEMENT_MSG_HEADERLEN;
   for(i = 0; i < adata.num; ++i) {
@@ -167,7 +169,7 @@ adv_packet_received(struct broadcast_conn *ibc, const linkaddr_t *from)
 static void
 adv_packet_sent(struct broadcast_conn *bc, int status, int num_tx)
 {
-
+  announcement_counters.sent++;
 }
 /*---------------------------------------------------------------------------*/
 static void send_timer(void *ptr);
@@ -175,6 +177,9 @@ static void send_timer(void *ptr);
 static void
 set_timers(void)
 {
+  if(c.slotted) {
+    return;
+  }
   ctimer_set(&c.interval_timer, c.current_interval, send_timer, NULL);
   ctimer_set(&c.send_timer, random_rand() % c.current_interval,
              send_adv, NULL);
@@ -245,6 +250,21 @@ broadcast_announcement_continue(void)
 }
 
 
+/*---------------------------------------------------------------------------*/
+void
+broadcast_announcement_set_slotted(uint8_t slotted)
+{
+  c.slotted = slotted;
+  if(slotted) {
+    broadcast_announcement_pause();
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+broadcast_announcement_send(void)
+{
+  send_adv(NULL);
+}
 /*---------------------------------------------------------------------------*/
 clock_time_t
 broadcast_announcement_beacon_interval(void)
@@ -68,6 +68,14 @@ void broadcast_announcement_stop(void);
 void broadcast_announcement_pause(void);
 void broadcast_announcement_continue(void);
 
+/**
+ * While slotted, the random beacon timers stay off and a beacon is
+ * only sent by broadcast_announcement_send(), at a time chosen by the
+ * caller (see csync-beacon).
+ */
+void broadcast_announcement_set_slotted(uint8_t slotted);
+void broadcast_announcement_send(void);
+
 clock_time_t broadcast_announcement_beacon_interval(void);
 
 #endif /* BROADCAST_ANNOUNCEMENT_H_ */
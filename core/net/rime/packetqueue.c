@@ -49,7 +49,7 @@
 void
 packetqueue_init(struct packetqueue *q)
 {
-  list_init(*q->list);
+  dlist_init(*q->list);
   memb_init(q->memb);
 }
 /*---------------------------------------------------------------------------*/
@@ -59,7 +59,7 @@ remove_queued_packet(void *item)
   struct packetqueue_item *i = item;
   struct packetqueue *q = i->queue;
 
-  list_remove(*q->list, i);
+  dlist_remove(*q->list, i);
   queuebuf_free(i->buf);
   ctimer_stop(&i->lifetimer);
   memb_free(q->memb, i);
@@ -98,7 +98,7 @@ packetqueue_enqueue_packetbuf(struct packetqueue *q, clock_time_t lifetime,
   }
 
   /* Add the item to the queue. */
-  list_add(*q->list, i);
+  dlist_add(*q->list, i);
 
   return 1;
 }
@@ -106,7 +106,7 @@ packetqueue_enqueue_packetbuf(struct packetqueue *q, clock_time_t lifetime,
 struct packetqueue_item *
 packetqueue_first(struct packetqueue *q)
 {
-  return list_head(*q->list);
+  return dlist_head(*q->list);
 }
 /*---------------------------------------------------------------------------*/
 void
@@ -114,9 +114,9 @@ packetqueue_dequeue(struct packetqueue *q)
 {
   struct packetqueue_item *i;
   
-  i = list_head(*q->list);
+  i = dlist_head(*q->list);
   if(i != NULL) {
-    list_remove(*q->list, i);
+    dlist_remove(*q->list, i);
     queuebuf_free(i->buf);
     ctimer_stop(&i->lifetimer);
     memb_free(q->memb, i);
@@ -126,7 +126,7 @@ packetqueue_dequeue(struct packetqueue *q)
 int
 packetqueue_len(struct packetqueue *q)
 {
-  return list_length(*q->list);
+  return dlist_length(*q->list);
 }
 /*---------------------------------------------------------------------------*/
 struct queuebuf *
@@ -54,6 +54,7 @@
 #define PACKETQUEUE_H_
 
 #include "lib/list.h"
+#include "lib/dlist.h"
 #include "lib/memb.h"
 
 #include "sys/ctimer.h"
@@ -68,7 +69,7 @@
  *             an opaque structure with no user-visible elements.
  */
 struct packetqueue {
-  list_t *list;
+  dlist_t *list;
   struct memb *memb;
 };
 
@@ -85,6 +86,7 @@ struct packetqueue {
  */
 struct packetqueue_item {
   struct packetqueue_item *next;
+  struct packetqueue_item *prev;
   struct queuebuf *buf;
   struct packetqueue *queue;
   struct ctimer lifetimer;
@@ -101,7 +103,7 @@ struct packetqueue_item {
  *             is defined on a per-module basis.
  *
  */
-#define PACKETQUEUE(name, size) LIST(name##_list); \
+#define PACKETQUEUE(name, size) DLIST(name##_list); \
                                 MEMB(name##_memb, struct packetqueue_item, size); \
 				static struct packetqueue name = { &name##_list, \
 								   &name##_memb }
@@ -151,6 +151,7 @@ adv_packet_received(struct ipolite_conn *ipolite, const linkaddr_t *from)
     //PRINTF("\nadata.num way out there: %d", adata.num);
     return;
   }
+  announcement_counters.received++;
 
   ptr += ANNOUNCEMENT_MSG_HEADERLEN;
   for(i = 0; i < adata.num; ++i) {
@@ -173,6 +174,7 @@ adv_packet_dropped(struct ipolite_conn *ipolite)
 static void
 adv_packet_sent(struct ipolite_conn *ipolite)
 {
+  announcement_counters.sent++;
   c.send_dups++;
   if(c.send_dups < c.max_send_dups)
   {
@@ -46,6 +46,10 @@
 #include "contiki.h"
 #include "lib/list.h"
 
+#include <stddef.h>
+
+/* Callback timers set before ctimer_process runs. Once it does, the
+   etimer of an expired callback timer leads back to it directly. */
 LIST(ctimer_list);
 
 static char initialized;
@@ -65,24 +69,24 @@ PROCESS_THREAD(ctimer_process, ev, data)
   struct ctimer *c;
   PROCESS_BEGIN();
 
-  for(c = list_head(ctimer_list); c != NULL; c = c->next) {
+  while((c = list_pop(ctimer_list)) != NULL) {
     etimer_set(&c->etimer, c->etimer.timer.interval);
   }
   initialized = 1;
 
   while(1) {
     PROCESS_YIELD_UNTIL(ev == PROCESS_EVENT_TIMER);
-    for(c = list_head(ctimer_list); c != NULL; c = c->next) {
-      if(&c->etimer == data) {
-	list_remove(ctimer_list, c);
-	PROCESS_CONTEXT_BEGIN(c->p);
-	if(c->f != NULL) {
-	  c->f(c->ptr);
-	}
-	PROCESS_CONTEXT_END(c->p);
-	break;
-      }
+    c = (struct ctimer *)((char *)data - offsetof(struct ctimer, etimer));
+    /* Stopped, or set again, after the event was posted */
+    if(!c->armed || !etimer_expired(&c->etimer)) {
+      continue;
+    }
+    c->armed = 0;
+    PROCESS_CONTEXT_BEGIN(c->p);
+    if(c->f != NULL) {
+      c->f(c->ptr);
     }
+    PROCESS_CONTEXT_END(c->p);
   }
   PROCESS_END();
 }
@@ -110,51 +114,54 @@ ctimer_set_with_process(struct ctimer *c, clock_time_t t,
   c->p = p;
   c->f = f;
   c->ptr = ptr;
+  c->armed = 1;
   if(initialized) {
     PROCESS_CONTEXT_BEGIN(&ctimer_process);
     etimer_set(&c->etimer, t);
     PROCESS_CONTEXT_END(&ctimer_process);
   } else {
     c->etimer.timer.interval = t;
+    list_add(ctimer_list, c);
   }
-
-  list_add(ctimer_list, c);
 }
 /*---------------------------------------------------------------------------*/
 void
 ctimer_reset(struct ctimer *c)
 {
+  c->armed = 1;
   if(initialized) {
     PROCESS_CONTEXT_BEGIN(&ctimer_process);
     etimer_reset(&c->etimer);
     PROCESS_CONTEXT_END(&ctimer_process);
+  } else {
+    list_add(ctimer_list, c);
   }
-
-  list_add(ctimer_list, c);
 }
 /*---------------------------------------------------------------------------*/
 void
 ctimer_restart(struct ctimer *c)
 {
+  c->armed = 1;
   if(initialized) {
     PROCESS_CONTEXT_BEGIN(&ctimer_process);
     etimer_restart(&c->etimer);
     PROCESS_CONTEXT_END(&ctimer_process);
+  } else {
+    list_add(ctimer_list, c);
   }
-
-  list_add(ctimer_list, c);
 }
 /*---------------------------------------------------------------------------*/
 void
 ctimer_stop(struct ctimer *c)
 {
+  c->armed = 0;
   if(initialized) {
     etimer_stop(&c->etimer);
   } else {
     c->etimer.next = NULL;
     c->etimer.p = PROCESS_NONE;
+    list_remove(ctimer_list, c);
   }
-  list_remove(ctimer_list, c);
 }
 /*---------------------------------------------------------------------------*/
 int
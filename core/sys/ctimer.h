@@ -62,6 +62,7 @@ struct ctimer {
   struct process *p;
   void (*f)(void *);
   void *ptr;
+  uint8_t armed;
 };
 
 /**
@@ -49,6 +49,8 @@
 #include "sys/etimer.h"
 #include "sys/process.h"
 
+/* Pending timers, sorted by expiration time. The timers that have
+   expired are always at the head of the list. */
 static struct etimer *timerlist;
 static clock_time_t next_expiration;
 
@@ -57,30 +59,60 @@ PROCESS(etimer_process, "Event timer");
 static void
 update_time(void)
 {
-  clock_time_t tdist;
-  clock_time_t now;
-  struct etimer *t;
-
-  if (timerlist == NULL) {
+  if(timerlist == NULL) {
     next_expiration = 0;
   } else {
-    now = clock_time();
-    t = timerlist;
-    /* Must calculate distance to next time into account due to wraps */
-    tdist = t->timer.start + t->timer.interval - now;
-    for(t = t->next; t != NULL; t = t->next) {
-      if(t->timer.start + t->timer.interval - now < tdist) {
-	tdist = t->timer.start + t->timer.interval - now;
-      }
+    next_expiration = timerlist->timer.start + timerlist->timer.interval;
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Ticks left before t expires, 0 once it has. The distance is taken
+   from now to cope with clock wraps. */
+static clock_time_t
+time_left(struct etimer *t, clock_time_t now)
+{
+  if((clock_time_t)(now - t->timer.start) >= t->timer.interval) {
+    return 0;
+  }
+  return t->timer.start + t->timer.interval - now;
+}
+/*---------------------------------------------------------------------------*/
+static void
+insert_timer(struct etimer *timer)
+{
+  struct etimer **tp;
+  clock_time_t now, left;
+
+  now = clock_time();
+  left = time_left(timer, now);
+
+  /* Timers expiring at the same time keep the order they were set in */
+  for(tp = &timerlist; *tp != NULL && time_left(*tp, now) <= left;
+      tp = &(*tp)->next);
+
+  timer->next = *tp;
+  *tp = timer;
+}
+/*---------------------------------------------------------------------------*/
+static int
+remove_timer(struct etimer *timer)
+{
+  struct etimer **tp;
+
+  for(tp = &timerlist; *tp != NULL; tp = &(*tp)->next) {
+    if(*tp == timer) {
+      *tp = timer->next;
+      timer->next = NULL;
+      return 1;
     }
-    next_expiration = now + tdist;
   }
+  return 0;
 }
 /*---------------------------------------------------------------------------*/
 PROCESS_THREAD(etimer_process, ev, data)
 {
-  struct etimer *t, *u;
-	
+  struct etimer *t, **tp;
+
   PROCESS_BEGIN();
 
   timerlist = NULL;
@@ -91,51 +123,36 @@ PROCESS_THREAD(etimer_process, ev, data)
     if(ev == PROCESS_EVENT_EXITED) {
       struct process *p = data;
 
-      while(timerlist != NULL && timerlist->p == p) {
-	timerlist = timerlist->next;
-      }
-
-      if(timerlist != NULL) {
-	t = timerlist;
-	while(t->next != NULL) {
-	  if(t->next->p == p) {
-	    t->next = t->next->next;
-	  } else
-	    t = t->next;
-	}
+      for(tp = &timerlist; *tp != NULL;) {
+        if((*tp)->p == p) {
+          *tp = (*tp)->next;
+        } else {
+          tp = &(*tp)->next;
+        }
       }
+      update_time();
       continue;
     } else if(ev != PROCESS_EVENT_POLL) {
       continue;
     }
 
-  again:
-    
-    u = NULL;
-    
-    for(t = timerlist; t != NULL; t = t->next) {
-      if(timer_expired(&t->timer)) {
-	if(process_post(t->p, PROCESS_EVENT_TIMER, t) == PROCESS_ERR_OK) {
-	  
-	  /* Reset the process ID of the event timer, to signal that the
-	     etimer has expired. This is later checked in the
-	     etimer_expired() function. */
-	  t->p = PROCESS_NONE;
-	  if(u != NULL) {
-	    u->next = t->next;
-	  } else {
-	    timerlist = t->next;
-	  }
-	  t->next = NULL;
-	  update_time();
-	  goto again;
-	} else {
-	  etimer_request_poll();
-	}
+    /* Only the head of the list has to be looked at */
+    while(timerlist != NULL && timer_expired(&timerlist->timer)) {
+      t = timerlist;
+      if(process_post(t->p, PROCESS_EVENT_TIMER, t) != PROCESS_ERR_OK) {
+        /* Event queue full, try again later */
+        etimer_request_poll();
+        break;
       }
-      u = t;
+
+      /* Reset the process ID of the event timer, to signal that the
+         etimer has expired. This is later checked in the
+         etimer_expired() function. */
+      t->p = PROCESS_NONE;
+      timerlist = t->next;
+      t->next = NULL;
     }
-    
+    update_time();
   }
   
   PROCESS_END();
@@ -150,26 +167,16 @@ etimer_request_poll(void)
 static void
 add_timer(struct etimer *timer)
 {
-  struct etimer *t;
-
   etimer_request_poll();
 
   if(timer->p != PROCESS_NONE) {
-    for(t = timerlist; t != NULL; t = t->next) {
-      if(t == timer) {
-	/* Timer already on list, bail out. */
-        timer->p = PROCESS_CURRENT();
-	update_time();
-	return;
-      }
-    }
+    /* Timer possibly on the list already, it is sorted in again with
+       its new expiration time */
+    remove_timer(timer);
   }
 
-  /* Timer not on list. */
   timer->p = PROCESS_CURRENT();
-  timer->next = timerlist;
-  timerlist = timer;
-
+  insert_timer(timer);
   update_time();
 }
 /*---------------------------------------------------------------------------*/
@@ -206,6 +213,9 @@ void
 etimer_adjust(struct etimer *et, int timediff)
 {
   et->timer.start += timediff;
+  if(et->p != PROCESS_NONE && remove_timer(et)) {
+    insert_timer(et);
+  }
   update_time();
 }
 /*---------------------------------------------------------------------------*/
@@ -242,25 +252,8 @@ etimer_next_expiration_time(void)
 void
 etimer_stop(struct etimer *et)
 {
-  struct etimer *t;
-
-  /* First check if et is the first event timer on the list. */
-  if(et == timerlist) {
-    timerlist = timerlist->next;
+  if(remove_timer(et)) {
     update_time();
-  } else {
-    /* Else walk through the list and try to find the item before the
-       et timer. */
-    for(t = timerlist; t != NULL && t->next != et; t = t->next);
-
-    if(t != NULL) {
-      /* We've found the item before the event timer that we are about
-	 to remove. We point the items next pointer to the event after
-	 the removed item. */
-      t->next = et->next;
-
-      update_time();
-    }
   }
 
   /* Remove the next pointer from the item to be removed. */
@@ -68,12 +68,34 @@ struct event_data {
 static process_num_events_t nevents, fevent;
 static struct event_data events[PROCESS_CONF_NUMEVENTS];
 
+/*
+ * Real-time events, delivered before any event of the queue above.
+ * Calls to process_post_rt() never overlap (see process.h), so there
+ * is one producer at a time: it only writes rt_put and the scheduler
+ * only writes rt_get. Both run freely and wrap together since the
+ * queue length is a power of two.
+ */
+static volatile struct event_data rt_events[PROCESS_CONF_NUMEVENTS_RT];
+static volatile process_num_events_t rt_put, rt_get;
+
+#define RT_PENDING() ((process_num_events_t)(rt_put - rt_get))
+
 #if PROCESS_CONF_STATS
 process_num_events_t process_maxevents;
+process_num_events_t process_maxevents_rt;
+unsigned short process_overflows;
+unsigned short process_overflows_rt;
 #endif
 
 static volatile unsigned char poll_requested;
 
+#if PROCESS_POLL_QUEUE
+/* Processes waiting for their poll handler, in the order they were
+   polled */
+static struct process *volatile pollhead;
+static struct process *volatile polltail;
+#endif /* PROCESS_POLL_QUEUE */
+
 #define PROCESS_STATE_NONE        0
 #define PROCESS_STATE_RUNNING     1
 #define PROCESS_STATE_CALLED      2
@@ -225,6 +247,28 @@ static void
 do_poll(void)
 {
   struct process *p;
+#if PROCESS_POLL_QUEUE
+  struct process *next;
+  PROCESS_ATOMIC_DECL(s);
+
+  /* Take the whole queue, processes polled from now on are handled
+     by the next call */
+  PROCESS_ATOMIC_BEGIN(s);
+  p = pollhead;
+  pollhead = polltail = NULL;
+  poll_requested = 0;
+  PROCESS_ATOMIC_END(s);
+
+  for(; p != NULL; p = next) {
+    next = p->pollnext;
+    p->needspoll = 0;
+    /* Exited after it was polled */
+    if(p->state != PROCESS_STATE_NONE) {
+      p->state = PROCESS_STATE_RUNNING;
+      call_process(p, PROCESS_EVENT_POLL, NULL);
+    }
+  }
+#else /* PROCESS_POLL_QUEUE */
 
   poll_requested = 0;
   /* Call the processes that needs to be polled. */
@@ -235,6 +279,7 @@ do_poll(void)
       call_process(p, PROCESS_EVENT_POLL, NULL);
     }
   }
+#endif /* PROCESS_POLL_QUEUE */
 }
 /*---------------------------------------------------------------------------*/
 /*
@@ -249,16 +294,30 @@ do_event(void)
   process_data_t data;
   struct process *receiver;
   struct process *p;
+  process_num_events_t get;
   
   /*
    * If there are any events in the queue, take the first one and walk
    * through the list of processes to see if the event should be
    * delivered to any of them. If so, we call the event handler
    * function for the process. We only process one event at a time and
-   * call the poll handlers inbetween.
+   * call the poll handlers inbetween. Real-time events go first.
    */
 
-  if(nevents > 0) {
+  if(RT_PENDING() > 0) {
+    get = rt_get;
+    ev = rt_events[get % PROCESS_CONF_NUMEVENTS_RT].ev;
+    data = rt_events[get % PROCESS_CONF_NUMEVENTS_RT].data;
+    receiver = rt_events[get % PROCESS_CONF_NUMEVENTS_RT].p;
+    if(ev == PROCESS_EVENT_POLL && receiver != PROCESS_BROADCAST) {
+      /* Polls from now on need an event of their own */
+      receiver->rtpoll = 0;
+    }
+
+    /* Gives the slot back to process_post_rt() */
+    rt_get = get + 1;
+
+  } else if(nevents > 0) {
     
     /* There are events that we should deliver. */
     ev = events[fevent].ev;
@@ -271,30 +330,33 @@ do_event(void)
     fevent = (fevent + 1) % PROCESS_CONF_NUMEVENTS;
     --nevents;
 
-    /* If this is a broadcast event, we deliver it to all events, in
-       order of their priority. */
-    if(receiver == PROCESS_BROADCAST) {
-      for(p = process_list; p != NULL; p = p->next) {
-
-	/* If we have been requested to poll a process, we do this in
-	   between processing the broadcast event. */
-	if(poll_requested) {
-	  do_poll();
-	}
-	call_process(p, ev, data);
-      }
-    } else {
-      /* This is not a broadcast event, so we deliver it to the
-	 specified process. */
-      /* If the event was an INIT event, we should also update the
-	 state of the process. */
-      if(ev == PROCESS_EVENT_INIT) {
-	receiver->state = PROCESS_STATE_RUNNING;
-      }
+  } else {
+    return;
+  }
+
+  /* If this is a broadcast event, we deliver it to all events, in
+     order of their priority. */
+  if(receiver == PROCESS_BROADCAST) {
+    for(p = process_list; p != NULL; p = p->next) {
 
-      /* Make sure that the process actually is running. */
-      call_process(receiver, ev, data);
+      /* If we have been requested to poll a process, we do this in
+	 between processing the broadcast event. */
+      if(poll_requested) {
+	do_poll();
+      }
+      call_process(p, ev, data);
+    }
+  } else {
+    /* This is not a broadcast event, so we deliver it to the
+       specified process. */
+    /* If the event was an INIT event, we should also update the
+       state of the process. */
+    if(ev == PROCESS_EVENT_INIT) {
+      receiver->state = PROCESS_STATE_RUNNING;
     }
+
+    /* Make sure that the process actually is running. */
+    call_process(receiver, ev, data);
   }
 }
 /*---------------------------------------------------------------------------*/
@@ -309,13 +371,13 @@ process_run(void)
   /* Process one event from the queue */
   do_event();
 
-  return nevents + poll_requested;
+  return nevents + RT_PENDING() + poll_requested;
 }
 /*---------------------------------------------------------------------------*/
 int
 process_nevents(void)
 {
-  return nevents + poll_requested;
+  return nevents + RT_PENDING() + poll_requested;
 }
 /*---------------------------------------------------------------------------*/
 int
@@ -340,6 +402,9 @@ process_post(struct process *p, process_event_t ev, process_data_t data)
       printf("soft panic: event queue is full when event %d was posted to %s from %s\n", ev, PROCESS_NAME_STRING(p), PROCESS_NAME_STRING(process_current));
     }
 #endif /* DEBUG */
+#if PROCESS_CONF_STATS
+    process_overflows++;
+#endif /* PROCESS_CONF_STATS */
     return PROCESS_ERR_FULL;
   }
   
@@ -358,6 +423,48 @@ process_post(struct process *p, process_event_t ev, process_data_t data)
   return PROCESS_ERR_OK;
 }
 /*---------------------------------------------------------------------------*/
+int
+process_post_rt(struct process *p, process_event_t ev, process_data_t data)
+{
+  process_num_events_t put = rt_put;
+  process_num_events_t snum;
+
+  if((process_num_events_t)(put - rt_get) == PROCESS_CONF_NUMEVENTS_RT) {
+#if PROCESS_CONF_STATS
+    process_overflows_rt++;
+#endif /* PROCESS_CONF_STATS */
+    return PROCESS_ERR_FULL;
+  }
+
+  snum = put % PROCESS_CONF_NUMEVENTS_RT;
+  rt_events[snum].ev = ev;
+  rt_events[snum].data = data;
+  rt_events[snum].p = p;
+  /* Published once the slot is written */
+  rt_put = put + 1;
+
+#if PROCESS_CONF_STATS
+  if(RT_PENDING() > process_maxevents_rt) {
+    process_maxevents_rt = RT_PENDING();
+  }
+#endif /* PROCESS_CONF_STATS */
+
+  return PROCESS_ERR_OK;
+}
+/*---------------------------------------------------------------------------*/
+void
+process_poll_rt(struct process *p)
+{
+  if(p == NULL || p->rtpoll) {
+    return;
+  }
+  if(process_post_rt(p, PROCESS_EVENT_POLL, NULL) == PROCESS_ERR_OK) {
+    p->rtpoll = 1;
+  } else {
+    process_poll(p);
+  }
+}
+/*---------------------------------------------------------------------------*/
 void
 process_post_synch(struct process *p, process_event_t ev, process_data_t data)
 {
@@ -370,11 +477,32 @@ process_post_synch(struct process *p, process_event_t ev, process_data_t data)
 void
 process_poll(struct process *p)
 {
+#if PROCESS_POLL_QUEUE
+  PROCESS_ATOMIC_DECL(s);
+#endif /* PROCESS_POLL_QUEUE */
+
   if(p != NULL) {
     if(p->state == PROCESS_STATE_RUNNING ||
        p->state == PROCESS_STATE_CALLED) {
+#if PROCESS_POLL_QUEUE
+      PROCESS_ATOMIC_BEGIN(s);
+      /* Queued only once until its poll handler has run */
+      if(!p->needspoll) {
+        p->pollnext = NULL;
+        if(polltail != NULL) {
+          polltail->pollnext = p;
+        } else {
+          pollhead = p;
+        }
+        polltail = p;
+      }
+      p->needspoll = 1;
+      poll_requested = 1;
+      PROCESS_ATOMIC_END(s);
+#else /* PROCESS_POLL_QUEUE */
       p->needspoll = 1;
       poll_requested = 1;
+#endif /* PROCESS_POLL_QUEUE */
     }
   }
 }
@@ -88,6 +88,15 @@ typedef unsigned char process_num_events_t;
 #define PROCESS_CONF_NUMEVENTS 32
 #endif /* PROCESS_CONF_NUMEVENTS */
 
+/* Length of the real-time event queue, a power of two */
+#ifndef PROCESS_CONF_NUMEVENTS_RT
+#define PROCESS_CONF_NUMEVENTS_RT 8
+#endif /* PROCESS_CONF_NUMEVENTS_RT */
+
+#if (PROCESS_CONF_NUMEVENTS_RT & (PROCESS_CONF_NUMEVENTS_RT - 1)) != 0
+#error PROCESS_CONF_NUMEVENTS_RT must be a power of two
+#endif
+
 #define PROCESS_EVENT_NONE            0x80
 #define PROCESS_EVENT_INIT            0x81
 #define PROCESS_EVENT_POLL            0x82
@@ -312,6 +321,24 @@ static PT_THREAD(process_thread_##name(struct pt *process_pt,	\
 
 /** @} */
 
+/*
+ * Polled processes are queued by process_poll(), so that the scheduler
+ * only looks at the processes that asked for it. The queue is shared
+ * with interrupt handlers, the platform provides the critical section
+ * with PROCESS_CONF_ATOMIC_BEGIN(s) and PROCESS_CONF_ATOMIC_END(s),
+ * which save and restore the interrupt state in s, declared with
+ * PROCESS_CONF_ATOMIC_DECL(s). Without them, the whole process list
+ * is walked for polls.
+ */
+#ifdef PROCESS_CONF_ATOMIC_BEGIN
+#define PROCESS_POLL_QUEUE 1
+#define PROCESS_ATOMIC_DECL(s) PROCESS_CONF_ATOMIC_DECL(s)
+#define PROCESS_ATOMIC_BEGIN(s) PROCESS_CONF_ATOMIC_BEGIN(s)
+#define PROCESS_ATOMIC_END(s) PROCESS_CONF_ATOMIC_END(s)
+#else
+#define PROCESS_POLL_QUEUE 0
+#endif
+
 struct process {
   struct process *next;
 #if PROCESS_CONF_NO_PROCESS_NAMES
@@ -322,7 +349,10 @@ struct process {
 #endif
   PT_THREAD((* thread)(struct pt *, process_event_t, process_data_t));
   struct pt pt;
-  unsigned char state, needspoll;
+  unsigned char state, needspoll, rtpoll;
+#if PROCESS_POLL_QUEUE
+  struct process *pollnext;
+#endif
 };
 
 /**
@@ -364,6 +394,42 @@ CCIF void process_start(struct process *p, process_data_t data);
  */
 CCIF int process_post(struct process *p, process_event_t ev, process_data_t data);
 
+/**
+ * Post a real-time event to a process.
+ *
+ * Real-time events have their own queue of PROCESS_CONF_NUMEVENTS_RT
+ * events, which the scheduler empties before it delivers any event
+ * posted with process_post(). The queue takes no lock, so calls must
+ * never overlap: a call may not be interrupted by another call. Any
+ * number of interrupt handlers may post as long as they cannot
+ * interrupt each other. A call from process context must mask the
+ * interrupts whose handlers also post.
+ *
+ * \param p The process to which the event should be posted, or
+ * PROCESS_BROADCAST.
+ *
+ * \param ev The event to be posted.
+ *
+ * \param data The auxiliary data to be sent with the event
+ *
+ * \retval PROCESS_ERR_OK The event could be posted.
+ *
+ * \retval PROCESS_ERR_FULL The real-time queue was full.
+ */
+int process_post_rt(struct process *p, process_event_t ev, process_data_t data);
+
+/**
+ * Poll a process through the real-time queue.
+ *
+ * Like process_poll(), polls that come before the process has seen
+ * the PROCESS_EVENT_POLL are merged into one. The same rules as for
+ * process_post_rt() apply. If the real-time queue is full, the process
+ * is polled with process_poll().
+ *
+ * \param p The process to be polled.
+ */
+void process_poll_rt(struct process *p);
+
 /**
  * Post a synchronous event to a process.
  *
@@ -519,6 +585,15 @@ CCIF int process_is_running(struct process *p);
  */
 int process_nevents(void);
 
+#if PROCESS_CONF_STATS
+/* High-water marks of the two event queues, and the number of events
+   dropped because they were full */
+extern process_num_events_t process_maxevents;
+extern process_num_events_t process_maxevents_rt;
+extern unsigned short process_overflows;
+extern unsigned short process_overflows_rt;
+#endif /* PROCESS_CONF_STATS */
+
 /** @} */
 
 CCIF extern struct process *process_list;
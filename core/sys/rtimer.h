@@ -173,6 +173,7 @@ uint32_t rtimer_lg_now(void);
 
 int8_t rtimer_compare(rtimer_id_t timer, uint32_t time_coarse_lg, uint32_t time_fine_lg);
 uint8_t rtimer_schedule(rtimer_id_t timer, rtimer_scheduletype_t interval, uint32_t time_coarse, uint32_t time_fine, rtimer_callback_t func);
+void rtimer_cancel(rtimer_id_t timer);
 
 void rtimer_sync_send(timesync_frame_t* syncframe);
 
@@ -209,7 +210,7 @@ int32_t rtimer_diff(int32_t time_a, int32_t time_b);
     TBCCR4 = TBCCR0 + (uint16_t)((rt[RTIMER_0].tb + RTIMER_AB_UPDATE_RESOLUTION) / clock_get_rate()); \
     TBCCTL4 |= CCIE; \
   } \
-  if(rt[RTIMER_1].state == RTIMER_SCHEDULED && (TACCR2 == rt[RTIMER_0].ta - RTIMER_AB_UPDATE) && rt[RTIMER_1].time_coarse_hw <= RTIMER_COARSE_NOW()) \
+  if(rt[RTIMER_1].state == RTIMER_SCHEDULED && (TACCR2 == rt[RTIMER_1].ta - RTIMER_AB_UPDATE) && rt[RTIMER_1].time_coarse_hw <= RTIMER_COARSE_NOW()) \
   { \
     TBCCR5 = TBCCR0 + (uint16_t)((rt[RTIMER_1].tb + RTIMER_AB_UPDATE_RESOLUTION) / clock_get_rate()); \
     TBCCTL5 |= CCIE; \
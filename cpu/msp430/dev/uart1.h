@@ -49,4 +49,16 @@ void uart1_writeb(unsigned char c);
 void uart1_init(unsigned long ubr);
 uint8_t uart1_active(void);
 
+/* Interrupt-driven transmission (UART1_CONF_TX_WITH_INTERRUPT) only,
+   zero otherwise: bytes waiting in the transmission buffer, bytes
+   dropped because it was full (UART1_CONF_TX_DROP) and the most bytes
+   it held */
+uint16_t uart1_tx_pending(void);
+uint16_t uart1_tx_dropped(void);
+uint16_t uart1_tx_max_queued(void);
+
+/* Wait until every byte written is sent, not to be called with
+   interrupts disabled */
+void uart1_flush(void);
+
 #endif /* UART1_H_ */
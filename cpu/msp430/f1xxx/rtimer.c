@@ -706,6 +706,17 @@ rtimer_schedule(rtimer_id_t timer,
 }
 
 
+/*---------------------------------------------------------------------------*/
+void
+rtimer_cancel(rtimer_id_t timer)
+{
+  if(timer < NUM_OF_RTIMERS)
+  {
+    rt[timer].state = RTIMER_INACTIVE;
+    rtimer_lf_update();
+  }
+}
+
 /*---------------------------------------------------------------------------*/
 void
 rtimer_sync_send(timesync_frame_t *syncframe)
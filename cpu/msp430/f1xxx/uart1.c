@@ -37,7 +37,7 @@
 #include "dev/uart1.h"
 #include "dev/watchdog.h"
 #include "sys/ctimer.h"
-#include "lib/ringbuf.h"
+#include "lib/ringbuf16.h"
 #include "isr_compat.h"
 
 static int (*uart1_input_handler)(unsigned char c);
@@ -57,11 +57,55 @@ static volatile uint8_t transmitting;
 #define RX_WITH_DMA 1
 #endif /* UART1_CONF_RX_WITH_DMA */
 
+/* With TX_DROP, a byte written while the transmission buffer is full
+   is dropped and counted instead of waiting for room */
+#ifdef UART1_CONF_TX_DROP
+#define TX_DROP UART1_CONF_TX_DROP
+#else /* UART1_CONF_TX_DROP */
+#define TX_DROP 0
+#endif /* UART1_CONF_TX_DROP */
+
 #if TX_WITH_INTERRUPT
+#ifdef UART1_CONF_TXBUFSIZE
+#define TXBUFSIZE UART1_CONF_TXBUFSIZE
+#else /* UART1_CONF_TXBUFSIZE */
 #define TXBUFSIZE 128
+#endif /* UART1_CONF_TXBUFSIZE */
+
+/* Bytes the interrupt takes from the buffer at once */
+#define TXBLOCK 16
 
-static struct ringbuf txbuf;
+static struct ringbuf16 txbuf;
 static uint8_t txbuf_data[TXBUFSIZE];
+
+/* Block being sent by the interrupt, freed in the buffer once sent */
+static uint8_t *txblock_ptr;
+static uint16_t txblock_len, txblock_left;
+
+static uint16_t tx_dropped;
+static uint16_t tx_max_queued;
+
+/*---------------------------------------------------------------------------*/
+/* Called with the TX interrupt disabled or from it */
+static void
+tx_next(void)
+{
+  if(txblock_left == 0) {
+    ringbuf16_commit_get(&txbuf, txblock_len);
+    txblock_len = ringbuf16_peek_get(&txbuf, &txblock_ptr);
+    if(txblock_len > TXBLOCK) {
+      txblock_len = TXBLOCK;
+    }
+    txblock_left = txblock_len;
+    if(txblock_left == 0) {
+      transmitting = 0;
+      return;
+    }
+  }
+  transmitting = 1;
+  txblock_left--;
+  TXBUF1 = *txblock_ptr++;
+}
 #endif /* TX_WITH_INTERRUPT */
 
 #if RX_WITH_DMA
@@ -110,19 +154,32 @@ uart1_writeb(unsigned char c)
   watchdog_periodic();
 #if TX_WITH_INTERRUPT
 
+#if TX_DROP
+  /* Put the outgoing byte on the transmission buffer, or drop it if
+     the buffer is full. */
+  if(ringbuf16_put(&txbuf, c) == 0) {
+    tx_dropped++;
+    return;
+  }
+#else /* TX_DROP */
   /* Put the outgoing byte on the transmission buffer. If the buffer
      is full, we just keep on trying to put the byte into the buffer
      until it is possible to put it there. */
-  while(ringbuf_put(&txbuf, c) == 0);
+  while(ringbuf16_put(&txbuf, c) == 0);
+#endif /* TX_DROP */
+
+  if(ringbuf16_elements(&txbuf) > tx_max_queued) {
+    tx_max_queued = ringbuf16_elements(&txbuf);
+  }
 
   /* If there is no transmission going, we need to start it by putting
      the first byte into the UART. */
   if(transmitting == 0) {
-    transmitting = 1;
-
-    /* Loop until the transmission buffer is available. */
-    /*while((IFG2 & UTXIFG1) == 0);*/
-    TXBUF1 = ringbuf_get(&txbuf);
+    IE2 &= ~UTXIE1;
+    if(transmitting == 0) {
+      tx_next();
+    }
+    IE2 |= UTXIE1;
   }
 
 #else /* TX_WITH_INTERRUPT */
@@ -135,6 +192,48 @@ uart1_writeb(unsigned char c)
 #endif /* TX_WITH_INTERRUPT */
 }
 /*---------------------------------------------------------------------------*/
+uint16_t
+uart1_tx_pending(void)
+{
+#if TX_WITH_INTERRUPT
+  return ringbuf16_elements(&txbuf);
+#else /* TX_WITH_INTERRUPT */
+  return 0;
+#endif /* TX_WITH_INTERRUPT */
+}
+/*---------------------------------------------------------------------------*/
+uint16_t
+uart1_tx_dropped(void)
+{
+#if TX_WITH_INTERRUPT
+  return tx_dropped;
+#else /* TX_WITH_INTERRUPT */
+  return 0;
+#endif /* TX_WITH_INTERRUPT */
+}
+/*---------------------------------------------------------------------------*/
+uint16_t
+uart1_tx_max_queued(void)
+{
+#if TX_WITH_INTERRUPT
+  return tx_max_queued;
+#else /* TX_WITH_INTERRUPT */
+  return 0;
+#endif /* TX_WITH_INTERRUPT */
+}
+/*---------------------------------------------------------------------------*/
+void
+uart1_flush(void)
+{
+#if TX_WITH_INTERRUPT
+  while(transmitting) {
+    watchdog_periodic();
+  }
+#endif /* TX_WITH_INTERRUPT */
+  /* The last byte leaves the shift register */
+  while((UTCTL1 & TXEPT) == 0);
+}
+/*---------------------------------------------------------------------------*/
 /**
  * Initalize the RS232 port.
  *
@@ -287,7 +386,8 @@ uart1_init(unsigned long ubr)
 
   IE2 |= URXIE1;                        /* Enable USART1 RX interrupt  */
 #if TX_WITH_INTERRUPT
-  ringbuf_init(&txbuf, txbuf_data, sizeof(txbuf_data));
+  ringbuf16_init(&txbuf, txbuf_data, sizeof(txbuf_data));
+  txblock_len = txblock_left = 0;
   IE2 |= UTXIE1;                        /* Enable USART1 TX interrupt  */
 #endif /* TX_WITH_INTERRUPT */
 
@@ -343,11 +443,7 @@ ISR(UART1TX, uart1_tx_interrupt)
 {
   ENERGEST_ON(ENERGEST_TYPE_IRQ);
 
-  if(ringbuf_elements(&txbuf) == 0) {
-    transmitting = 0;
-  } else {
-    TXBUF1 = ringbuf_get(&txbuf);
-  }
+  tx_next();
 
   ENERGEST_OFF(ENERGEST_TYPE_IRQ);
 }
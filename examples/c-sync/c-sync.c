@@ -40,6 +40,42 @@
 
 
 #include "net/c-sync/c-sync.h"
+#include "net/c-sync/csync-phase.h"
+#include "net/c-sync/csync-coloring.h"
+#include "net/c-sync/csync-sync.h"
+#include "dev/uart1.h"
+#if CSYNC_TDMA
+#include "net/c-sync/csync-tdma.h"
+#endif /*CSYNC_TDMA*/
+#if CSYNC_DATA_LOAD
+#include "lib/random.h"
+#endif /*CSYNC_DATA_LOAD*/
+#if CSYNC_AGG
+#include "net/c-sync/csync-agg.h"
+#endif /*CSYNC_AGG*/
+#if CSYNC_MULTICHANNEL
+#include "net/c-sync/csync-channel.h"
+#endif /*CSYNC_MULTICHANNEL*/
+#if CSYNC_DEDUP
+#include "net/c-sync/csync-dedup.h"
+#endif /*CSYNC_DEDUP*/
+#if CSYNC_HIST
+#include "net/c-sync/csync-hist.h"
+#endif /*CSYNC_HIST*/
+#if CSYNC_TEMP
+#include "net/c-sync/csync-temp.h"
+#endif /*CSYNC_TEMP*/
+#if CSYNC_BEACON
+#include "net/c-sync/csync-beacon.h"
+#endif /*CSYNC_BEACON*/
+#if CSYNC_CHURN
+#include "net/c-sync/csync-churn.h"
+#endif /*CSYNC_CHURN*/
+#if CSYNC_SHELL
+#include "serial-shell.h"
+#include "shell.h"
+#include "shell-csync.h"
+#endif /*CSYNC_SHELL*/
 
 #define DEBUG 1
 #if DEBUG
@@ -69,7 +105,16 @@ LIST(blacklist);
 MEMB(bl_memb, struct BL, NUM_BL_MAX);
 
 PROCESS(c_gtsp_process, "Clustering with embedded GTSP");
+#if CSYNC_DATA_LOAD
+PROCESS(data_load_process, "Data load over C-sync clusters");
+AUTOSTART_PROCESSES(&c_gtsp_process, &data_load_process);
+#else /*CSYNC_DATA_LOAD*/
 AUTOSTART_PROCESSES(&c_gtsp_process);
+#endif /*CSYNC_DATA_LOAD*/
+
+#if CSYNC_AGG
+static int16_t agg_sample(void);
+#endif /*CSYNC_AGG*/
 
 static struct CHB *ch;
 static uint8_t temp_state;
@@ -84,35 +129,23 @@ static uint8_t saved_slot_ack = 0;
 static uint8_t saved_sync_border = 0;
 #endif
 static uint8_t convergence_complete = 0;
+static uint8_t late_declaration = 0;
 static uint8_t soft_reset_count = 0;
 
-inline char
-enter_election_revelation(rtimer_t *rt)
+/*---------------------------------------------------------------------------*/
+/* Phase specific parts of the transitions, run in the rtimer ISR */
+static void
+action_election_revelation(void)
 {
     broadcast_announcement_stop();
-    announcement_remove_value(&discovery_announcement);
-    
-    rtimer_coarse_schedule_ref = rt[RTIMER_0].time_coarse_hw;
-    rtimer_fine_schedule_ref = rt[RTIMER_0].time_fine_hw;
-
-    my_state = ELECTION_REVELATION;
     sync_LC_addr = my_addr; // Initialization before Consensus Sync
-    process_poll(&c_gtsp_process);
-    return 0;
 }
 
-/*---------------------------------------------------------------------------*/
-inline char 
-enter_election_declaration(rtimer_t *rt)
-{ 
-    polite_announcement_cancel();
-    announcement_remove_value(&revelation_announcement);
-
+static void
+action_election_declaration(void)
+{
     csync_update_placing();
     polite_announcement_set_interval(POLITE_INTERVAL * my_placing);
-    
-    rtimer_coarse_schedule_ref = rt[RTIMER_0].time_coarse_hw;
-    rtimer_fine_schedule_ref = rt[RTIMER_0].time_fine_hw; 
 
 #if TEST_BYZ
     if((my_addr == 69) || (my_addr == 65))
@@ -130,63 +163,212 @@ enter_election_declaration(rtimer_t *rt)
     else
         my_cluster.role = CM;
 #endif 
+}
 
-    my_state = ELECTION_DECLARATION;
+static void
+action_connection_revelation(void)
+{
+    NETSTACK_RADIO.off();
+}
 
-    process_poll(&c_gtsp_process);
-    return 0;
+static void
+action_connection_declaration(void)
+{
+    packetbuf_set_attr(PACKETBUF_ATTR_CSYNC_CONN_DOAES, 0);
+    NETSTACK_LLSEC.init();
 }
 
-/*---------------------------------------------------------------------------*/
-inline char
-enter_connection_revelation(rtimer_t *rt)
+static void
+action_consensus_revelation(void)
 {
-    polite_announcement_cancel();
+    polite_announcement_set_interval(POLITE_INTERVAL * my_placing);
+    NETSTACK_RADIO.on();
+}
+
+static void
+action_idle(void)
+{
+    polite_announcement_stop();
     NETSTACK_RADIO.off();
-    announcement_remove_value(&declaration_announcement);
 
-    rtimer_coarse_schedule_ref = rt[RTIMER_0].time_coarse_hw;
-    rtimer_fine_schedule_ref = rt[RTIMER_0].time_fine_hw; 
+    leds_off(LEDS_GREEN); 
+
+    if(cons_ctrl_counter + 1 >= NUM_CONS_CTRL_ITERATIONS)
+    {
+        leds_off(LEDS_RED);
+        leds_off(LEDS_BLUE);
+    }
+}
 
-    my_state = CONNECTION_REVELATION;
+/*---------------------------------------------------------------------------*/
+/**
+ * Phase table, indexed by CSYNC_PHASE_INDEX(state). A phase lasts
+ * duration from its reference, owns one announcement, which is retired
+ * when the next phase is entered, and ends by entering next.
+ */
+struct phase {
+    uint32_t duration;
+    struct announcement *a;
+    void (*action)(void);
+    rtimer_callback_t enter;
+    state_t next;
+};
+
+static const struct phase phases[CSYNC_PHASE_NUM] = {
+    {(uint32_t)(DISC_TO_EREV_INTERVAL), &discovery_announcement, NULL, enter_discovery, ELECTION_REVELATION},
+    {(uint32_t)(REGULAR_SLOT_INTERVAL), &revelation_announcement, action_election_revelation, enter_election_revelation, ELECTION_DECLARATION},
+    {(uint32_t)(REGULAR_SLOT_INTERVAL), &declaration_announcement, action_election_declaration, enter_election_declaration, CONNECTION_REVELATION},
+    {(uint32_t)(REGULAR_SLOT_INTERVAL), &revelation_announcement, action_connection_revelation, enter_connection_revelation, CONNECTION_DECLARATION},
+    {(uint32_t)(REGULAR_SLOT_INTERVAL), &declaration_announcement, action_connection_declaration, enter_connection_declaration, CONSENSUS_CONVERGENCE},
+    {(uint32_t)(CONS_CTRL_SLOT_INTERVAL*NUM_CONS_SLOTS), &convergence_announcement, NULL, enter_convergence, CONSENSUS_REVELATION},
+    {(uint32_t)(REGULAR_SLOT_INTERVAL), &revelation_announcement, action_consensus_revelation, enter_consensus_revelation, CONSENSUS_SYNCHRONIZATION},
+    {(uint32_t)(CONS_CTRL_SLOT_INTERVAL*CSYNC_CONS_SLOTS), &synchronization_announcement, NULL, enter_consensus_synchronization, IDLE},
+    {(uint32_t)(IDLE_SLOT_INTERVAL), &discovery_announcement, action_idle, enter_idle, DISCOVERY},
+    {0, &synchronization_announcement, NULL, enter_byzantine_consensus, CONSENSUS_SYNCHRONIZATION},
+};
 
-    process_poll(&c_gtsp_process);
-    return 0;
+/*---------------------------------------------------------------------------*/
+/* Wakes p with a real-time event, ahead of the shell and serial events.
+   Wakes before p has run are merged into one, so that a phase end and a
+   received announcement never move p on by two steps. Phases are
+   entered from RTIMER_0 as well as from process context, so the poll
+   is masked: process_post_rt() calls must never overlap */
+void
+csync_wake(struct process *p)
+{
+    spl_t s = splhigh();
+
+    process_poll_rt(p);
+    splx(s);
 }
 
 /*---------------------------------------------------------------------------*/
-inline char
-enter_connection_declaration(rtimer_t *rt)
+/* Common part of every transition: retire the announcement of the
+   phase before, take the reference of the new phase and hand over to
+   the process */
+static char
+enter_phase(rtimer_t *rt, state_t state)
 {
-    polite_announcement_cancel();
-    announcement_remove_value(&revelation_announcement);
+    const struct phase *p;
 
-    packetbuf_set_attr(PACKETBUF_ATTR_CSYNC_CONN_DOAES, 0);
-    NETSTACK_LLSEC.init();
+    /* DISCOVERY has no phase before it to retire */
+    if(CSYNC_PHASE_INDEX(state) == 0 || CSYNC_PHASE_INDEX(state) >= CSYNC_PHASE_NUM)
+    {
+        return 0;
+    }
+    p = &phases[CSYNC_PHASE_INDEX(state)];
+
+    /* The polite announcements are only set up in ELECTION_REVELATION,
+       there is nothing of them to cancel yet when entering it */
+    if(state != ELECTION_REVELATION)
+    {
+        polite_announcement_cancel();
+    }
+    announcement_remove_value(phases[CSYNC_PHASE_INDEX(state) - 1].a);
+    if(p->action != NULL)
+    {
+        p->action();
+    }
 
     rtimer_coarse_schedule_ref = rt[RTIMER_0].time_coarse_hw;
-    rtimer_fine_schedule_ref = rt[RTIMER_0].time_fine_hw; 
+    rtimer_fine_schedule_ref = rt[RTIMER_0].time_fine_hw;
 
-    my_state = CONNECTION_DECLARATION;
+    my_state = state;
+    CSYNC_PHASE_SWITCH(my_state);
 
-    process_poll(&c_gtsp_process);
+    csync_wake(&c_gtsp_process);
     return 0;
 }
 
+/*---------------------------------------------------------------------------*/
+/* Arm the end of the current phase, relative to its reference */
+static uint8_t
+arm_phase_end(void)
+{
+    const struct phase *p = &phases[CSYNC_PHASE_INDEX(my_state)];
+
+    return rtimer_schedule(RTIMER_0, RTIMER_INTERVAL_REF, 0, p->duration, phases[CSYNC_PHASE_INDEX(p->next)].enter);
+}
+
+/*---------------------------------------------------------------------------*/
+/* The end of the current phase is already within the safety margin of
+   rtimer_schedule(): enter the next phase at once, with the reference
+   the table gives for it, instead of leaving RTIMER_0 unarmed */
+static void
+skip_phase(void)
+{
+    const struct phase *p = &phases[CSYNC_PHASE_INDEX(my_state)];
+    uint32_t coarse = 0;
+    uint32_t fine = p->duration;
+
+    rtimer_lginterval_to_hwdate(&coarse, &fine, RTIMER_INTERVAL_REF);
+    rt[RTIMER_0].time_coarse_hw = coarse;
+    rt[RTIMER_0].time_fine_hw = fine;
+    phases[CSYNC_PHASE_INDEX(p->next)].enter(rt);
+}
+
+/*---------------------------------------------------------------------------*/
+/* Sets and sends the announcement of a phase, dated with the end of
+   the current one */
+static void
+announce_phase(state_t state, uint8_t degree, uint16_t ref_addr)
+{
+    struct announcement *a = phases[CSYNC_PHASE_INDEX(state)].a;
+
+    announcement_set_instr(a, my_state);
+    announcement_set_degree(a, degree);
+    announcement_set_date_coarse(a, rt[RTIMER_0].time_coarse_lg); //PRELIMINARY
+    announcement_set_date_fine(a, rt[RTIMER_0].time_fine_lg); //PRELIMINARY
+    announcement_set_ref_addr(a, ref_addr);
+    announcement_set_cons_rate(a, TRUE);
+    announcement_add_value(a);
+    announcement_bump(a);
+}
+
+/*---------------------------------------------------------------------------*/
+inline char
+enter_election_revelation(rtimer_t *rt)
+{
+    return enter_phase(rt, ELECTION_REVELATION);
+}
+
 /*---------------------------------------------------------------------------*/
 inline char 
-enter_convergence(rtimer_t *rt)
+enter_election_declaration(rtimer_t *rt)
+{ 
+    return enter_phase(rt, ELECTION_DECLARATION);
+}
+
+/*---------------------------------------------------------------------------*/
+inline char
+enter_connection_revelation(rtimer_t *rt)
 {
-    polite_announcement_cancel();
-    announcement_remove_value(&declaration_announcement);
+    return enter_phase(rt, CONNECTION_REVELATION);
+}
 
-    rtimer_coarse_schedule_ref = rt[RTIMER_0].time_coarse_hw;
-    rtimer_fine_schedule_ref = rt[RTIMER_0].time_fine_hw; 
-    
-    my_state = CONSENSUS_CONVERGENCE;
+/*---------------------------------------------------------------------------*/
+/* A CONNECTION_DECLARATION was heard before leaving ELECTION_DECLARATION
+   and RTIMER_0 already ends CONNECTION_DECLARATION: go through
+   CONNECTION_REVELATION without arming it and declare right away */
+char
+enter_connection_late(rtimer_t *rt)
+{
+    late_declaration = 1;
+    return enter_phase(rt, CONNECTION_REVELATION);
+}
 
-    process_poll(&c_gtsp_process);
-    return 0;
+/*---------------------------------------------------------------------------*/
+inline char
+enter_connection_declaration(rtimer_t *rt)
+{
+    return enter_phase(rt, CONNECTION_DECLARATION);
+}
+
+/*---------------------------------------------------------------------------*/
+inline char 
+enter_convergence(rtimer_t *rt)
+{
+    return enter_phase(rt, CONSENSUS_CONVERGENCE);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -197,7 +379,7 @@ enter_convergence_slot(rtimer_t *rt)
     if(my_cons_slot < NUM_CONS_SLOTS)
     {
         convergence_complete = 1;
-        process_poll(&c_gtsp_process);
+        csync_wake(&c_gtsp_process);
         return 0;
     }
     enter_consensus_revelation(rt);
@@ -208,18 +390,7 @@ enter_convergence_slot(rtimer_t *rt)
 inline char 
 enter_consensus_revelation(rtimer_t *rt)
 {
-    polite_announcement_cancel();
-    announcement_remove_value(&convergence_announcement);
-    polite_announcement_set_interval(POLITE_INTERVAL * my_placing);
-    NETSTACK_RADIO.on();
-
-    rtimer_coarse_schedule_ref = rt[RTIMER_0].time_coarse_hw;
-    rtimer_fine_schedule_ref = rt[RTIMER_0].time_fine_hw; 
-    
-    my_state = CONSENSUS_REVELATION;
-
-    process_poll(&c_gtsp_process);
-    return 0;
+    return enter_phase(rt, CONSENSUS_REVELATION);
 }
 
 
@@ -227,16 +398,7 @@ enter_consensus_revelation(rtimer_t *rt)
 inline char 
 enter_consensus_synchronization(rtimer_t *rt)
 {
-    polite_announcement_cancel();
-    announcement_remove_value(&revelation_announcement);
-
-    rtimer_coarse_schedule_ref = rt[RTIMER_0].time_coarse_hw;
-    rtimer_fine_schedule_ref = rt[RTIMER_0].time_fine_hw; 
-
-    my_state = CONSENSUS_SYNCHRONIZATION;
-
-    process_poll(&c_gtsp_process);
-    return 0;
+    return enter_phase(rt, CONSENSUS_SYNCHRONIZATION);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -248,7 +410,7 @@ enter_byzantine_consensus(rtimer_t *rt)
         temp_state = BYZANTINE_CONSENSUS;
     else
         temp_state = my_state;
-    process_poll(&c_gtsp_process);
+    csync_wake(&c_gtsp_process);
     return 0;
 }
 
@@ -257,9 +419,9 @@ static inline char
 enter_synchronization_slot(rtimer_t *rt)
 {
     polite_announcement_cancel();
-    if(ref_n_CHB_degree - 1 < NUM_CONS_SLOTS)
+    if(ref_n_CHB_degree - 1 < CSYNC_CONS_SLOTS)
     {
-        process_poll(&c_gtsp_process);
+        csync_wake(&c_gtsp_process);
         return 0;
     }
     enter_idle(rt);
@@ -280,30 +442,13 @@ enter_idle(rtimer_t *rt)
     PRINTF("Inside enter_idle\n");
     
     my_state = IDLE;
+    CSYNC_PHASE_SWITCH(my_state);
 
-    process_poll(&c_gtsp_process);
+    csync_wake(&c_gtsp_process);
     return 0;
 #endif //TEST_GTSP
 
-    polite_announcement_stop();
-    announcement_remove_value(&synchronization_announcement);
-    NETSTACK_RADIO.off();
-
-    rtimer_coarse_schedule_ref = rt[RTIMER_0].time_coarse_hw;
-    rtimer_fine_schedule_ref = rt[RTIMER_0].time_fine_hw;
-
-    leds_off(LEDS_GREEN); 
-
-    if(cons_ctrl_counter + 1 >= NUM_CONS_CTRL_ITERATIONS)
-    {
-        leds_off(LEDS_RED);
-        leds_off(LEDS_BLUE);
-    }
-
-    my_state = IDLE;
-
-    process_poll(&c_gtsp_process);
-    return 0;
+    return enter_phase(rt, IDLE);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -314,15 +459,16 @@ enter_discovery(rtimer_t *rt)
     broadcast_announcement_stop();
     rtimer_coarse_schedule_ref = rt[RTIMER_0].time_coarse_hw;
     rtimer_fine_schedule_ref = rt[RTIMER_0].time_fine_hw; 
-    process_poll(&c_gtsp_process);
+    csync_wake(&c_gtsp_process);
     my_state = DISCOVERY;
+    CSYNC_PHASE_SWITCH(my_state);
     return 0;
 #endif
     polite_announcement_stop();
     rtimer_coarse_schedule_ref = rt[RTIMER_0].time_coarse_hw;
     rtimer_fine_schedule_ref = rt[RTIMER_0].time_fine_hw; 
 
-    process_poll(&c_gtsp_process);
+    csync_wake(&c_gtsp_process);
     return 0;
 }
 
@@ -330,28 +476,34 @@ enter_discovery(rtimer_t *rt)
 PROCESS_THREAD(c_gtsp_process, ev, data)
 {  
 
-    /* Dummy delay code added for Indriya testbed for allowing print statements*/
-    int c; 
-    // if(my_addr >= 1 && my_addr <= 15)
-    //     for (c = 0; c <= 23500; c++);
-    // else if(my_addr >= 16 && my_addr <= 25)
-    //     for (c = 0; c <= 17500; c++);
-    // else if(my_addr >= 26 && my_addr <= 39)
-    //     for (c = 0; c <= 21800; c++);
-    // else if(my_addr >= 40 && my_addr <= 48)
-    //     for (c = 0; c <= 22400; c++);
-    // else if(my_addr >= 49 && my_addr <= 61)
-    //     for (c = 0; c <= 20500; c++);
-    // else if(my_addr >= 62 && my_addr <= 78)
-    //     for (c = 0; c <= 18500; c++);
-    for (c = 1; c <= 19000; c++); 
+    /* Boot messages are sent before the protocol starts (Indriya testbed) */
+    static struct etimer drain_timer;
 
     PROCESS_EXITHANDLER(broadcast_announcement_stop());
     PROCESS_BEGIN();
 
+    while(uart1_tx_pending() > 0)
+    {
+        etimer_set(&drain_timer, 1);
+        PROCESS_WAIT_UNTIL(etimer_expired(&drain_timer));
+    }
+
 
     // DISCOVERY
     reset_c_gtsp(); 
+#if CSYNC_MULTICHANNEL
+    csync_channel_init();
+#endif /*CSYNC_MULTICHANNEL*/
+#if CSYNC_AGG
+    csync_agg_open(&CSYNC_AGG_OPERATOR, agg_sample, NULL);
+#endif /*CSYNC_AGG*/
+#if CSYNC_TEMP
+    csync_temp_open(csync_all_synced);
+#endif /*CSYNC_TEMP*/
+#if CSYNC_SHELL
+    serial_shell_init();
+    shell_csync_init();
+#endif /*CSYNC_SHELL*/
     
     while(1)
     { 
@@ -360,118 +512,88 @@ PROCESS_THREAD(c_gtsp_process, ev, data)
         
         csync_print_status();
 
-        PROCESS_YIELD();
+        /* Every step of the state machine is woken by csync_wake(). Shell
+           lines and the exit of shell commands are broadcast to every
+           process, so each wait below only takes the poll */
+        PROCESS_YIELD_UNTIL(ev == PROCESS_EVENT_POLL);
         // ELECTION_REVELATION
 
         while(my_state < CONSENSUS_CONVERGENCE)
         {
+            if(my_state == DISCOVERY)
+            {
+                PROCESS_YIELD_UNTIL(ev == PROCESS_EVENT_POLL);
+                continue;
+            }
+            if(my_state == ELECTION_REVELATION)
+            {
+                polite_announcement_init(LOGICAL_CHANNEL, 0, PA_RESILIENCE_MAX_SEND_DUPS, PA_REGULAR_MAX_RECV_DUPS);
+            }
+
+            if(!late_declaration && !arm_phase_end())
+            {
+                PRINTF(" late");
+                skip_phase();
+                continue;
+            }
+
+            csync_print_status();
             switch(my_state)
             {
                 case ELECTION_REVELATION:
-                {
-                    if(rtimer_schedule(RTIMER_0, RTIMER_INTERVAL_REF, 0, REGULAR_SLOT_INTERVAL, enter_election_declaration))
-                    {
-                        polite_announcement_init(LOGICAL_CHANNEL, 0, PA_RESILIENCE_MAX_SEND_DUPS, PA_REGULAR_MAX_RECV_DUPS);
-                        csync_print_status();
-                        announcement_set_instr(&revelation_announcement, my_state);
-                        announcement_set_degree(&revelation_announcement, my_degree);
-                        announcement_set_date_coarse(&revelation_announcement, rt[RTIMER_0].time_coarse_lg); //PRELIMINARY
-                        announcement_set_date_fine(&revelation_announcement, rt[RTIMER_0].time_fine_lg); //PRELIMINARY
-                        announcement_set_ref_addr(&revelation_announcement, my_addr);
-                        announcement_set_cons_rate(&revelation_announcement, TRUE);
-                        announcement_add_value(&revelation_announcement);
-                        announcement_bump(&revelation_announcement);
-                        break;
-                    }
-                }
+                    announce_phase(ELECTION_REVELATION, my_degree, my_addr);
+                    break;
+
                 case ELECTION_DECLARATION:
-                {
-                    if(rtimer_schedule(RTIMER_0, RTIMER_INTERVAL_REF, 0, REGULAR_SLOT_INTERVAL, enter_connection_revelation))
-                    {
-                        csync_print_status();
-                        announcement_set_instr(&declaration_announcement, my_state);
-                        announcement_set_degree(&declaration_announcement, my_degree);
-                        announcement_set_date_coarse(&declaration_announcement, rt[RTIMER_0].time_coarse_lg); //PRELIMINARY
-                        announcement_set_date_fine(&declaration_announcement, rt[RTIMER_0].time_fine_lg); //PRELIMINARY
-                        announcement_set_ref_addr(&declaration_announcement, my_addr);
-                        announcement_set_cons_rate(&declaration_announcement, TRUE);
-                        announcement_add_value(&declaration_announcement);
-                        announcement_bump(&declaration_announcement);
-                        break;
-                    }
-                }
+                    announce_phase(ELECTION_DECLARATION, my_degree, my_addr);
+                    break;
+
                 case CONNECTION_REVELATION:
                 {
-                    if(rtimer_schedule(RTIMER_0, RTIMER_INTERVAL_REF, 0, REGULAR_SLOT_INTERVAL, enter_connection_declaration))
+                    if(list_length(*my_cluster.CHs_list) > 1 && my_cluster.role == CM)
                     {
-                        csync_print_status();
-                        if(list_length(*my_cluster.CHs_list) > 1 && my_cluster.role == CM)
-                        {
-                            NETSTACK_RADIO.on();
+                        NETSTACK_RADIO.on();
 
-                            my_cluster.role = CB;
-                            my_placing -= csync_CHB_placing();
-                            polite_announcement_set_interval(POLITE_INTERVAL * my_placing);
-
-                            announcement_set_instr(&revelation_announcement, my_state);
-                            announcement_set_degree(&revelation_announcement, my_degree);
-                            announcement_set_date_coarse(&revelation_announcement, rt[RTIMER_0].time_coarse_lg); //PRELIMINARY
-                            announcement_set_date_fine(&revelation_announcement, rt[RTIMER_0].time_fine_lg); //PRELIMINARY
-                            announcement_set_cons_rate(&revelation_announcement, TRUE);
-
-                            ch = list_head(*my_cluster.CHs_list);
-                            ref_n_CHB_addr = ch->addr;
-                            ref_n_CHB_degree = ch->degree;
-                            packetbuf_set_attr(PACKETBUF_ATTR_CSYNC_CONN_AES_XORPLAINTEXT_A, ch->addr);
-                            ch = list_item_next(ch);
-                            ref_n_CHB_addr += ch->addr;
-                            ref_n_CHB_degree += ch->degree;
-
-                            packetbuf_set_attr(PACKETBUF_ATTR_CSYNC_CONN_AES_XORPLAINTEXT_B, ch->addr);
-                            packetbuf_set_attr(PACKETBUF_ATTR_CSYNC_CONN_DOAES, 1);
-                            NETSTACK_LLSEC.init();
-
-                            announcement_set_ref_addr(&revelation_announcement, ref_n_CHB_addr); //PRELIMINARY
-                            announcement_add_value(&revelation_announcement);
-                            announcement_bump(&revelation_announcement);
-                        }
+                        my_cluster.role = CB;
+                        my_placing -= csync_CHB_placing();
+                        polite_announcement_set_interval(POLITE_INTERVAL * my_placing);
+
+                        ch = list_head(*my_cluster.CHs_list);
+                        ref_n_CHB_addr = ch->addr;
+                        ref_n_CHB_degree = ch->degree;
+                        packetbuf_set_attr(PACKETBUF_ATTR_CSYNC_CONN_AES_XORPLAINTEXT_A, ch->addr);
+                        ch = list_item_next(ch);
+                        ref_n_CHB_addr += ch->addr;
+                        ref_n_CHB_degree += ch->degree;
+
+                        packetbuf_set_attr(PACKETBUF_ATTR_CSYNC_CONN_AES_XORPLAINTEXT_B, ch->addr);
+                        packetbuf_set_attr(PACKETBUF_ATTR_CSYNC_CONN_DOAES, 1);
+                        NETSTACK_LLSEC.init();
+
+                        announce_phase(CONNECTION_REVELATION, my_degree, ref_n_CHB_addr); //PRELIMINARY
                     }
-                    if(rt[RTIMER_0].func == enter_convergence)
+                    if(!late_declaration)
                     {
-                        rt[RTIMER_0].state = RTIMER_SINGLEPASS;
-                    }
-                    else
                         break;
+                    }
+                    late_declaration = 0;
                 }
 
                 case CONNECTION_DECLARATION:
-                {
-                    if(rtimer_schedule(RTIMER_0, RTIMER_INTERVAL_REF, 0, REGULAR_SLOT_INTERVAL, enter_convergence))
+                    if(my_cluster.role == CH)
                     {
-                        csync_print_status();
-                        if(my_cluster.role == CH)
-                        {
-                            NETSTACK_RADIO.on();
-                        }
-                        else if(my_cluster.role == CB)
-                        {
-                            announcement_set_instr(&declaration_announcement, my_state);
-                            announcement_set_degree(&declaration_announcement, ref_n_CHB_degree);
-                            announcement_set_date_coarse(&declaration_announcement, rt[RTIMER_0].time_coarse_lg); //PRELIMINARY
-                            announcement_set_date_fine(&declaration_announcement, rt[RTIMER_0].time_fine_lg); //PRELIMINARY
-                            announcement_set_ref_addr(&declaration_announcement, ref_n_CHB_addr); //PRELIMINARY
-                            announcement_set_cons_rate(&declaration_announcement, TRUE);
-                            announcement_add_value(&declaration_announcement);
-                            announcement_bump(&declaration_announcement);
-                            break;
-                        }
+                        NETSTACK_RADIO.on();
                     }
-                }
+                    else if(my_cluster.role == CB)
+                    {
+                        announce_phase(CONNECTION_DECLARATION, ref_n_CHB_degree, ref_n_CHB_addr); //PRELIMINARY
+                    }
+                    break;
 
                 default:
                     break;
             }
-            PROCESS_YIELD();
+            PROCESS_YIELD_UNTIL(ev == PROCESS_EVENT_POLL);
         }
 
         // while(cons_ctrl_counter < NUM_CONS_CTRL_ITERATIONS)
@@ -497,7 +619,7 @@ PROCESS_THREAD(c_gtsp_process, ev, data)
                 broadcast_announcement_init(LOGICAL_CHANNEL, IDLE_MIN_INTERVAL, IDLE_MIN_INTERVAL, IDLE_MAX_INTERVAL);
 #endif /*IDLE_BROADCASTS*/
 
-                PROCESS_YIELD();
+                PROCESS_YIELD_UNTIL(ev == PROCESS_EVENT_POLL);
                     
 #if IDLE_BROADCAST
                 broadcast_announcement_stop();
@@ -512,10 +634,26 @@ PROCESS_THREAD(c_gtsp_process, ev, data)
 
 #else
             
+#if CSYNC_CHURN
+        if(csync_churn_joined())
+        {
+            /* Attached to a running cluster in the middle of its IDLE,
+               go on with its next consensus round from the end of it */
+            cons_ctrl_counter = 1;
+            saved_proactive_slot = 1;
+            saved_cons_slot = 1;
+            saved_slot_ack = 0;
+            saved_sync_border = 0;
+            PROCESS_YIELD_UNTIL(ev == PROCESS_EVENT_POLL);
+            goto consensus_rounds;
+        }
+#endif /*CSYNC_CHURN*/
+
         leds_on(LEDS_GREEN);
         if(cons_ctrl_counter > 0)
         {
             my_state = CONSENSUS_CONVERGENCE;
+            CSYNC_PHASE_SWITCH(my_state);
             if(my_cluster.role > CM)
             {
                 NETSTACK_RADIO.on();
@@ -532,7 +670,7 @@ PROCESS_THREAD(c_gtsp_process, ev, data)
             polite_announcement_init(LOGICAL_CHANNEL, my_placing, PA_RESILIENCE_MAX_SEND_DUPS, PA_REGULAR_MAX_RECV_DUPS);
         }
 
-        if(rtimer_schedule(RTIMER_0, RTIMER_INTERVAL_REF, 0, CONS_CTRL_SLOT_INTERVAL*NUM_CONS_SLOTS, enter_consensus_revelation))
+        if(arm_phase_end())
         {
             csync_print_status();
             announcement_set_date_coarse(&convergence_announcement, rt[RTIMER_0].time_coarse_lg); //PRELIMINARY
@@ -583,6 +721,14 @@ PROCESS_THREAD(c_gtsp_process, ev, data)
                         {
                             my_slot_ack = 0;
                         }
+#if CSYNC_COLORING
+                        else if(my_cluster.role == CH && !my_slot_ack && csync_coloring_may_claim())
+                        {
+                            PRINTF(" slot %u c %u", my_cons_slot, csync_coloring_pick());
+                            announcement_set_degree(&convergence_announcement, csync_coloring_pick());
+                            announcement_bump(&convergence_announcement);
+                        }
+#else
                         else if(my_cluster.role == CH && !my_slot_ack && (n_CH_count <= 1 || my_cons_slot == my_proactive_slot))
                         {
                             PRINTF(" slot %u", my_cons_slot);
@@ -596,10 +742,11 @@ PROCESS_THREAD(c_gtsp_process, ev, data)
                             announcement_bump(&convergence_announcement);
                             //PRINTF(" BUMP");
                         }
+#endif /*CSYNC_COLORING*/
 
                         if(my_cons_slot < NUM_CONS_SLOTS)
                         {
-                            PROCESS_YIELD();
+                            PROCESS_YIELD_UNTIL(ev == PROCESS_EVENT_POLL);
 
                             if(my_cluster.role == CB)
                             {
@@ -611,7 +758,7 @@ PROCESS_THREAD(c_gtsp_process, ev, data)
                             if(my_slot_ack)
                             {
                                 NETSTACK_RADIO.off();
-                                if(rtimer_schedule(RTIMER_0, RTIMER_INTERVAL_REF, 0, CONS_CTRL_SLOT_INTERVAL*NUM_CONS_SLOTS, enter_consensus_revelation))
+                                if(arm_phase_end())
                                 {
                                     break;
                                 }
@@ -638,15 +785,22 @@ PROCESS_THREAD(c_gtsp_process, ev, data)
                         my_cons_slot++;
                     }
                 }
+#if CSYNC_COLORING
+                /* No CB acknowledged a colour in time, keep the lowest free one */
+                if(my_cluster.role == CH && !my_slot_ack && list_length(*my_cluster.CHs_list) > 0)
+                {
+                    my_cons_slot = csync_coloring_pick();
+                }
+#endif /*CSYNC_COLORING*/
             }
         }
 
         if(my_cons_slot <= NUM_CONS_SLOTS)
         {
-            PROCESS_YIELD();
+            PROCESS_YIELD_UNTIL(ev == PROCESS_EVENT_POLL);
 
             // CONSENSUS_REVELATION
-            if(rtimer_schedule(RTIMER_0, RTIMER_INTERVAL_REF, 0, REGULAR_SLOT_INTERVAL, enter_consensus_synchronization))
+            if(arm_phase_end())
             {
                 csync_print_status();
                 /* Let all the common nodes know the slot to wake up */
@@ -661,16 +815,20 @@ PROCESS_THREAD(c_gtsp_process, ev, data)
                     announcement_add_value(&revelation_announcement);
                     announcement_bump(&revelation_announcement);
                 }
-                PROCESS_YIELD();
+                PROCESS_YIELD_UNTIL(ev == PROCESS_EVENT_POLL);
             }
         }
 
+#if CSYNC_CHURN
+consensus_rounds:
+#endif /*CSYNC_CHURN*/
         
         while (cons_ctrl_counter < NUM_CONS_CTRL_ITERATIONS)
         {
             if(cons_ctrl_counter > 0)
             {
                 my_state = CONSENSUS_SYNCHRONIZATION;
+                CSYNC_PHASE_SWITCH(my_state);
                 if(my_cluster.role > CM)
                 {
                     NETSTACK_RADIO.on();
@@ -682,7 +840,7 @@ PROCESS_THREAD(c_gtsp_process, ev, data)
                 my_sync_border = saved_sync_border;
                 for(ch = list_head(*my_cluster.CHs_list); ch != NULL; ch = list_item_next(ch))
                 {
-                    ch->cons_slot = (NUM_CONS_SLOTS + 1) - ch->cons_slot;
+                    ch->cons_slot = (CSYNC_CONS_SLOTS + 1) - ch->cons_slot;
                 }
                 polite_announcement_init(LOGICAL_CHANNEL, my_placing, PA_RESILIENCE_MAX_SEND_DUPS, PA_REGULAR_MAX_RECV_DUPS);
             }
@@ -696,10 +854,13 @@ PROCESS_THREAD(c_gtsp_process, ev, data)
             }
 
             // CONSENSUS_SYNCHRONIZATION
-            if(rtimer_schedule(RTIMER_0, RTIMER_INTERVAL_REF, 0, CONS_CTRL_SLOT_INTERVAL*NUM_CONS_SLOTS, enter_idle))
+            if(arm_phase_end())
             {
                 init_consensus_synchronization();
                 csync_print_status();
+#if CSYNC_MULTICHANNEL
+                csync_channel_cluster();
+#endif /*CSYNC_MULTICHANNEL*/
 
                 if(my_cluster.role == CH)
                 {
@@ -724,18 +885,21 @@ PROCESS_THREAD(c_gtsp_process, ev, data)
 
                 //PRINTF(" my_cons_slot %u", my_cons_slot);
 
-                while(ref_n_CHB_degree - 1 <= NUM_CONS_SLOTS)
+                while(ref_n_CHB_degree - 1 <= CSYNC_CONS_SLOTS)
                 {
                     if(rtimer_schedule(RTIMER_0, RTIMER_INTERVAL_REF, 0, CONS_CTRL_SLOT_INTERVAL*(ref_n_CHB_degree - 1), enter_synchronization_slot))
                     {
-                        if(ref_n_CHB_degree - 1 < NUM_CONS_SLOTS)
+                        if(ref_n_CHB_degree - 1 < CSYNC_CONS_SLOTS)
                         {
-                            PROCESS_YIELD();
+                            PROCESS_YIELD_UNTIL(ev == PROCESS_EVENT_POLL);
 
                             //PRINTF(" slot %u", ref_n_CHB_degree);
                             NETSTACK_RADIO.on();
                             
                             this_sync_slot = ref_n_CHB_degree;
+#if CSYNC_MULTICHANNEL
+                            csync_channel_slot(this_sync_slot);
+#endif /*CSYNC_MULTICHANNEL*/
                             if(my_sync_border && this_sync_slot == my_cons_slot)
                             {
                                 //PRINTF(" BUMPB");
@@ -777,7 +941,7 @@ PROCESS_THREAD(c_gtsp_process, ev, data)
                                         announcement_set_instr(&synchronization_announcement, temp_state);
                                         announcement_bump(&synchronization_announcement);
                                     }
-                                    PROCESS_YIELD();
+                                    PROCESS_YIELD_UNTIL(ev == PROCESS_EVENT_POLL);
                                     /* Do process poll in receive synchronization message */
                                     if((my_sync_border) && (msg_count < (my_degree/2 + 1)))
                                     {
@@ -814,30 +978,64 @@ PROCESS_THREAD(c_gtsp_process, ev, data)
                 }
 
 
-                if(ref_n_CHB_degree - 2 <= NUM_CONS_SLOTS)
+                if(ref_n_CHB_degree - 2 <= CSYNC_CONS_SLOTS)
                 {
-                    PROCESS_YIELD();
+                    PROCESS_YIELD_UNTIL(ev == PROCESS_EVENT_POLL);
                     // IDLE
+#if CSYNC_MULTICHANNEL
+                    csync_channel_restore();
+#endif /*CSYNC_MULTICHANNEL*/
 
                     //PRINTF("\n %lu, %lu", rtimer_coarse_schedule_ref, rtimer_fine_schedule_ref);
                     if(rtimer_schedule(RTIMER_0, RTIMER_DATE, announcement_get_date_coarse(&synchronization_announcement), announcement_get_date_fine(&synchronization_announcement) + IDLE_SLOT_INTERVAL, enter_discovery))
                     {
                         csync_print_status();
+#if CSYNC_CHURN
+                        if(csync_churn_age() == CSYNC_CHURN_REPAIRED)
+                        {
+                            /* Lost a CH as CB, go on as CM of the other one */
+                            saved_slot_ack = 0;
+                            saved_sync_border = 0;
+                        }
+#endif /*CSYNC_CHURN*/
 #if IDLE_BROADCAST
                         NETSTACK_RADIO.on();
                         announcement_set_instr(&discovery_announcement, my_state);
+#if CSYNC_CHURN
+                        /* Tell late nodes which CH to join and its slot: as in the
+                           CONS_CTRL phases, degree carries the consensus slot here
+                           instead of cons_ctrl_counter, and ref_addr the CH */
+                        announcement_set_degree(&discovery_announcement, my_cons_slot);
+                        announcement_set_ref_addr(&discovery_announcement, csync_churn_cluster());
+#else /*CSYNC_CHURN*/
                         announcement_set_degree(&discovery_announcement, cons_ctrl_counter);
+                        announcement_set_ref_addr(&discovery_announcement, my_addr);
+#endif /*CSYNC_CHURN*/
                         announcement_set_date_coarse(&discovery_announcement, rt[RTIMER_0].time_coarse_lg); //PRELIMINARY
                         announcement_set_date_fine(&discovery_announcement, rt[RTIMER_0].time_fine_lg); //PRELIMINARY
                         announcement_set_cons_rate(&discovery_announcement, TRUE);
-                        announcement_set_ref_addr(&discovery_announcement, my_addr);
                         announcement_add_value(&discovery_announcement);
                         broadcast_announcement_init(LOGICAL_CHANNEL, IDLE_MIN_INTERVAL, IDLE_MIN_INTERVAL, IDLE_MAX_INTERVAL);
+#if CSYNC_BEACON
+                        csync_beacon_start(announcement_get_date_coarse(&synchronization_announcement), announcement_get_date_fine(&synchronization_announcement));
+#endif /*CSYNC_BEACON*/
 #endif /*IDLE_BROADCASTS*/
-
-                        PROCESS_YIELD();
+#if CSYNC_TDMA
+                        csync_tdma_start(announcement_get_date_coarse(&synchronization_announcement), announcement_get_date_fine(&synchronization_announcement));
+#endif /*CSYNC_TDMA*/
+#if CSYNC_AGG
+                        csync_agg_start_round();
+#endif /*CSYNC_AGG*/
+
+                        PROCESS_YIELD_UNTIL(ev == PROCESS_EVENT_POLL);
                         
+#if CSYNC_TDMA
+                        csync_tdma_stop();
+#endif /*CSYNC_TDMA*/
 #if IDLE_BROADCAST
+#if CSYNC_BEACON
+                        csync_beacon_stop();
+#endif /*CSYNC_BEACON*/
                         broadcast_announcement_stop();
                         announcement_remove_value(&discovery_announcement);
                         PRINTF("\n");
@@ -846,12 +1044,103 @@ PROCESS_THREAD(c_gtsp_process, ev, data)
                 }
             }
             cons_ctrl_counter++;
+#if CSYNC_CHURN
+            /* Keep the clusters and go on with the next consensus round
+               instead of clustering the whole network again. Only a node
+               that lost its cluster goes back to DISCOVERY to join another */
+            if(csync_churn_lost())
+            {
+                break;
+            }
+            if(cons_ctrl_counter >= NUM_CONS_CTRL_ITERATIONS)
+            {
+                cons_ctrl_counter = 1;
+            }
+#endif /*CSYNC_CHURN*/
         }
         #endif
     }
     PROCESS_END();
 }
 
+/*---------------------------------------------------------------------------*/
+#if CSYNC_AGG
+/* Sample for the aggregation service: the largest offset to any
+   neighbour, in rtimer ticks */
+static int16_t
+agg_sample(void)
+{
+    neighbour_t *n;
+    int32_t diff, max = 0;
+
+    for(n = list_head(csync_neighbour_list()); n != NULL; n = list_item_next(n))
+    {
+        diff = labs(n->fine_diff);
+        if(diff > max)
+        {
+            max = diff;
+        }
+    }
+    return max > 0x7fff ? 0x7fff : (int16_t)max;
+}
+#endif /*CSYNC_AGG*/
+
+/*---------------------------------------------------------------------------*/
+#if CSYNC_DATA_LOAD
+struct data_msg {
+    uint16_t seqno;
+    uint32_t lg_sent;
+};
+
+static void
+data_recv(struct broadcast_conn *c, const linkaddr_t *from)
+{
+    struct data_msg msg;
+
+    if(packetbuf_datalen() < sizeof(struct data_msg))
+    {
+        return;
+    }
+    memcpy(&msg, packetbuf_dataptr(), sizeof(struct data_msg));
+
+    /* Both ends run on the synchronized logical clock */
+    PRINTF("\n%u D %u s %u lat %ld", my_addr, from->u16, msg.seqno, RTIMER_HF_TO_MS((int32_t)(rtimer_lg_now() - msg.lg_sent)));
+}
+
+static const struct broadcast_callbacks data_callbacks = {data_recv};
+static struct broadcast_conn data_conn;
+
+PROCESS_THREAD(data_load_process, ev, data)
+{
+    static struct etimer et;
+    static struct data_msg msg;
+
+    PROCESS_EXITHANDLER(broadcast_close(&data_conn));
+    PROCESS_BEGIN();
+
+    broadcast_open(&data_conn, CSYNC_DATA_CHANNEL, &data_callbacks);
+    msg.seqno = 0;
+
+    while(1)
+    {
+        etimer_set(&et, CSYNC_DATA_LOAD_INTERVAL / 2 + random_rand() % CSYNC_DATA_LOAD_INTERVAL);
+        PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+
+        if(my_state != IDLE)
+        {
+            continue;
+        }
+
+        msg.seqno++;
+        msg.lg_sent = rtimer_lg_now();
+        packetbuf_copyfrom(&msg, sizeof(struct data_msg));
+        broadcast_send(&data_conn);
+    }
+
+    PROCESS_END();
+}
+#endif /*CSYNC_DATA_LOAD*/
+
 /*---------------------------------------------------------------------------*/
 void reset_c_gtsp(void)
 {
@@ -863,6 +1152,8 @@ void reset_c_gtsp(void)
     list_init(mod_neighbour_list);
 #endif /*MOD_NEIGHBOURS*/
 
+    CSYNC_SYNC.init();
+
     //cc2420_set_txpower(30);
 
     ref_n_CHB_degree = 0;
@@ -883,6 +1174,10 @@ void reset_c_gtsp(void)
     my_degree = 0;
 #endif /*MOD_NEIGHBOURS*/
     my_state = DISCOVERY;
+    csync_phase_init();
+#if CSYNC_HIST
+    csync_hist_init();
+#endif /*CSYNC_HIST*/
     my_placing = 0;
     my_cluster.role = CH;
     soft_reset_count = 0;
@@ -927,9 +1222,17 @@ void reset_c_gtsp(void)
 void 
 soft_reset(void)
 {
+    /* Whichever way the last round ended, nothing of IDLE keeps running */
+#if CSYNC_BEACON
+    csync_beacon_stop();
+#endif /*CSYNC_BEACON*/
+#if CSYNC_TDMA
+    csync_tdma_stop();
+#endif /*CSYNC_TDMA*/
 
     announcement_init();
     my_state = DISCOVERY;
+    CSYNC_PHASE_SWITCH(my_state);
 
     rtimer_coarse_schedule_ref = 0;
     rtimer_fine_schedule_ref = 0;
@@ -944,9 +1247,16 @@ soft_reset(void)
     my_sync_border = 0;
     cons_ctrl_counter = 0;
     msg_count = 0;
+    late_declaration = 0;
 
     soft_reset_count++;
+#if CSYNC_CHURN
+    csync_churn_reset();
+#endif /*CSYNC_CHURN*/
 
+#if CSYNC_MULTICHANNEL
+    csync_channel_restore();
+#endif /*CSYNC_MULTICHANNEL*/
     NETSTACK_RADIO.set_value(RADIO_PARAM_CCA_THRESHOLD, RADIO_CCA_THRESHOLD);
     NETSTACK_RADIO.on();
 
@@ -1094,6 +1404,37 @@ csync_print_status(void)
     else if(my_state == IDLE)
     {
         PRINTF("-> I");
+#if CSYNC_TDMA
+        csync_tdma_print_stats();
+#endif /*CSYNC_TDMA*/
+#if CSYNC_AGG
+        csync_agg_print_stats(); // previous round
+#endif /*CSYNC_AGG*/
+#if CSYNC_DEDUP
+        csync_dedup_print_stats();
+#endif /*CSYNC_DEDUP*/
+#if CSYNC_HIST
+        csync_hist_print_percentiles();
+#endif /*CSYNC_HIST*/
+#if CSYNC_TEMP
+        csync_temp_print_stats();
+#endif /*CSYNC_TEMP*/
+#if CSYNC_BEACON
+        csync_beacon_print_stats(); // previous IDLE
+#endif /*CSYNC_BEACON*/
+#if CSYNC_CHURN
+        csync_churn_print_stats();
+#endif /*CSYNC_CHURN*/
+#if CSYNC_PHASE_STATS
+        csync_phase_print_binary();
+#endif /*CSYNC_PHASE_STATS*/
+#if UART1_CONF_TX_DROP
+        printf("\n%u TX d %u h %u", my_addr, uart1_tx_dropped(), uart1_tx_max_queued());
+#endif /*UART1_CONF_TX_DROP*/
+#if PROCESS_CONF_STATS
+        printf("\n%u EQ h %u rt %u o %u rt %u", my_addr, process_maxevents,
+               process_maxevents_rt, process_overflows, process_overflows_rt);
+#endif /*PROCESS_CONF_STATS*/
         powertrace_print("");
         PRINTF("\n");
     }
@@ -1122,23 +1463,72 @@ csync_all_synced(void)
     struct neighbour *n;
 
 #if MOD_NEIGHBOURS
-    for(n = list_head(mod_neighbour_list); n != NULL; n = list_item_next(n))
+    list_t list = mod_neighbour_list;
+#else /*MOD_NEIGHBOURS*/
+    list_t list = neighbour_list;
+#endif /*MOD_NEIGHBOURS*/
+
+    for(n = list_head(list); n != NULL; n = list_item_next(n))
     {
-        if(n->synced == 0 || n->state > 1)
+        if(n->state > 1)
         {
             return 0;
         }
     }
+    return CSYNC_SYNC.synced(list);
+}
+
+/*---------------------------------------------------------------------------*/
+list_t
+csync_neighbour_list(void)
+{
+#if MOD_NEIGHBOURS
+    return mod_neighbour_list;
 #else /*MOD_NEIGHBOURS*/
-    for(n = list_head(neighbour_list); n != NULL; n = list_item_next(n))
+    return neighbour_list;
+#endif /*MOD_NEIGHBOURS*/
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+remove_CHB(list_t list, struct memb *m, uint16_t addr)
+{
+    struct CHB *c, *next;
+
+    for(c = list_head(list); c != NULL; c = next)
     {
-        if(n->synced == 0 || n->state > 1)
+        next = list_item_next(c);
+        if(c->addr == addr)
         {
-            return 0;
+            list_remove(list, c);
+            memb_free(m, c);
         }
     }
+}
+
+/* Forgets a neighbour, together with its CH and CB entries */
+void
+csync_neighbour_remove(neighbour_t *n)
+{
+#if MOD_NEIGHBOURS
+    if(check_mod_neighbours(n->addr))
+    {
+        list_remove(mod_neighbour_list, n);
+        my_degree--;
+    }
+    else
+    {
+        list_remove(neighbour_list, n);
+    }
+#else /*MOD_NEIGHBOURS*/
+    list_remove(neighbour_list, n);
+    my_degree--;
 #endif /*MOD_NEIGHBOURS*/
-    return 1;
+    announcement_set_degree(&discovery_announcement, my_degree);
+
+    remove_CHB(*my_cluster.CHs_list, my_cluster.m_CH, n->addr);
+    remove_CHB(*my_cluster.CBs_list, my_cluster.m_CB, n->addr);
+    memb_free(&neighbour_memb, n);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -1739,7 +2129,8 @@ struct neighbour* add_to_neighbour(uint16_t addr, uint8_t state, uint8_t degree,
     {
         if(n->addr == addr && check_mod_neighbours(n->addr))
         {
-            gtsp_recv(n, syncframe, 0);
+            n->last_heard = (uint16_t)clock_seconds();
+            CSYNC_SYNC.recv(n, syncframe, 0);
 
             if((my_addr == 64) && (my_state >= CONSENSUS_SYNCHRONIZATION))
                 PRINTF("\n");
@@ -1756,7 +2147,7 @@ struct neighbour* add_to_neighbour(uint16_t addr, uint8_t state, uint8_t degree,
             n->state = state;
             if((my_state < CONSENSUS_SYNCHRONIZATION && state == my_state) || my_state == DISCOVERY)
             {
-                gtsp_update_rtimer(mod_neighbour_list); 
+                CSYNC_SYNC.update(mod_neighbour_list, n);
             }
             // For local center synchronization
             // else if((my_state == CONSENSUS_SYNCHRONIZATION) && (my_cluster.role == CH) && (my_cons_slot == this_sync_slot))
@@ -1777,7 +2168,8 @@ struct neighbour* add_to_neighbour(uint16_t addr, uint8_t state, uint8_t degree,
     {
         if(n->addr == addr)
         {
-            gtsp_recv(n, syncframe, 0);
+            n->last_heard = (uint16_t)clock_seconds();
+            CSYNC_SYNC.recv(n, syncframe, 0);
             return NULL;
         }
     }
@@ -1786,7 +2178,8 @@ struct neighbour* add_to_neighbour(uint16_t addr, uint8_t state, uint8_t degree,
     {
         if(n->addr == addr)
         {
-            gtsp_recv(n, syncframe, 0);
+            n->last_heard = (uint16_t)clock_seconds();
+            CSYNC_SYNC.recv(n, syncframe, 0);
 
             if(my_state == IDLE)
             {
@@ -1800,7 +2193,7 @@ struct neighbour* add_to_neighbour(uint16_t addr, uint8_t state, uint8_t degree,
             n->state = state;
             if((my_state < CONSENSUS_SYNCHRONIZATION && state == my_state) || my_state == DISCOVERY)
             {
-                gtsp_update_rtimer(neighbour_list);
+                CSYNC_SYNC.update(neighbour_list, n);
             }
 
             if(my_state < CONNECTION_DECLARATION)
@@ -1822,6 +2215,7 @@ struct neighbour* add_to_neighbour(uint16_t addr, uint8_t state, uint8_t degree,
         }
 
         n->addr = addr;
+        n->last_heard = (uint16_t)clock_seconds();
         if(my_state < CONNECTION_DECLARATION)
         {
             n->degree = degree;
@@ -1832,19 +2226,19 @@ struct neighbour* add_to_neighbour(uint16_t addr, uint8_t state, uint8_t degree,
 #if MOD_NEIGHBOURS
         if(check_mod_neighbours(n->addr))
         {
-            gtsp_recv(n, syncframe, 1);
+            CSYNC_SYNC.recv(n, syncframe, 1);
             my_degree++;
             list_add(mod_neighbour_list, n);
             announcement_set_degree(&discovery_announcement, my_degree);
         }
         else
         {
-            gtsp_recv(n, syncframe, 1);
+            CSYNC_SYNC.recv(n, syncframe, 1);
             list_add(neighbour_list, n);
             return NULL;
         }
 #else /*MOD_NEIGHBOURS*/
-        gtsp_recv(n, syncframe, 1);
+        CSYNC_SYNC.recv(n, syncframe, 1);
         my_degree++;
         list_add(neighbour_list, n);
         announcement_set_degree(&discovery_announcement, my_degree);
@@ -2052,4 +2446,4 @@ csync_trusted_synchronization(neighbour_t *n, uint16_t c_addr, double cons_rate)
 #endif /*MOD_NEIGHBOURS*/ 
     
     PRINTF(", sync C %u, N %u @ %ld", c_addr, n->addr, n_fine_diff);
-}
\ No newline at end of file
+}
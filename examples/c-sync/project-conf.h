@@ -4,9 +4,14 @@
 #undef NETSTACK_NETWORK
 #define NETSTACK_NETWORK rime_driver
 #undef NETSTACK_CONF_LLSEC
-#define NETSTACK_CONF_LLSEC nullsec_driver
+#define NETSTACK_CONF_LLSEC csyncsec_driver
+#define CSYNC_TDMA 0 // default 0, 1 for the slotted data plane in IDLE instead of CSMA
 #undef NETSTACK_CONF_MAC
+#if CSYNC_TDMA
+#define NETSTACK_CONF_MAC  csync_tdma_driver
+#else
 #define NETSTACK_CONF_MAC  csma_driver
+#endif
 #undef NETSTACK_CONF_RDC
 #define NETSTACK_CONF_RDC csyncrdc_framer_driver 
 #undef NETSTACK_CONF_FRAMER
@@ -47,12 +52,56 @@
 
 
 #define MOD_NEIGHBOURS 1 // default 0, 1 for hardcoded neighbours to create topologies
+#ifndef MOD_TYPE // DEFINES=MOD_TYPE=n on the make command line, see regression-tests/28-c-sync
 #define MOD_TYPE 1 // 1 for full network, 2 for chain, 6 for sparse network, 7 for dense network, 3 for byzantine testing
+#endif
 #define TEST_GTSP 0 // default 0, 1 for GTSP testing
+#ifndef CSYNC_CONF_SYNC
+#define CSYNC_CONF_SYNC gtsp_driver // default gtsp_driver, ftsp_driver to run the same clustering on FTSP
+#endif
+#ifndef TEST_BYZ
 #define TEST_BYZ 0 // default 0, 1 for Byzantine fault testing
+#endif
 
 #define AVG_CONSENSUS 0
 
+// DATA LOAD, to compare CSMA against CSYNC_TDMA under the same traffic
+#define CSYNC_DATA_LOAD 0 // default 0, 1 to broadcast data packets while IDLE
+#define CSYNC_DATA_CHANNEL 14
+#define CSYNC_DATA_LOAD_INTERVAL (CLOCK_SECOND / 4)
+
+// AGGREGATION, one round per IDLE period, results printed by the sink
+// (DEFINES=CSYNC_AGG=1,... on the make command line, see regression-tests/28-c-sync)
+#ifndef CSYNC_AGG
+#define CSYNC_AGG 0 // default 0, 1 to aggregate samples over the CH/CB hierarchy
+#endif
+#define CSYNC_AGG_OPERATOR csync_agg_max // csync_agg_min, csync_agg_avg, csync_agg_histogram, csync_agg_sync_error (needs CSYNC_HIST)
+#ifndef CSYNC_AGG_CONF_SINK
+#define CSYNC_AGG_CONF_SINK 48 // default 1, node address of the sink
+#endif
+#ifndef CSYNC_AGG_CONF_MERGE
+#define CSYNC_AGG_CONF_MERGE 1 // 0 forwards every sample, to compare the transmissions per round
+#endif
+
+#define CSYNC_PHASE_CONF_STATS 1 // default 1, energy and beacons per C-sync phase (PB line in IDLE)
+
+#define CSYNC_MULTICHANNEL 0 // default 0, 1 to run every cluster on the channel of its CH during CONSENSUS_SYNCHRONIZATION
+#define CSYNC_DEDUP 0 // default 0, 1 to handle every revelation and declaration once, copies only feed GTSP
+#define CSYNC_HIST 0 // default 0, 1 for log2 histograms of the sync error per neighbour (HP line in IDLE, csync-hist shell command)
+#define CSYNC_TEMP 0 // default 0, 1 to learn avg_rate per temperature and pre-correct it when the temperature changes (TC line in IDLE)
+#define CSYNC_BEACON 0 // default 0, 1 for IDLE beacons in fixed slots on logical time instead of at random (not with CSYNC_TDMA)
+#define CSYNC_CHURN 0 // default 0, 1 to keep the clusters after the consensus rounds, age out neighbours and let late nodes join a running CH (CC line in IDLE)
+
+// Serial output is sent from the UART interrupt, printf() never waits for the UART
+#define UART1_CONF_TX_WITH_INTERRUPT 1
+#define UART1_CONF_TXBUFSIZE 256 // power of two
+#ifndef UART1_CONF_TX_DROP // DEFINES=UART1_CONF_TX_DROP=0 to keep every log byte
+#define UART1_CONF_TX_DROP 1 // default 0, 1 to drop log bytes when the TX buffer is full instead of waiting for room (TX line in IDLE)
+#endif
+
+// Room for the 802.15.4 header in front of queued frames, so CSMA retransmissions and the RDC send them in place
+#define QUEUEBUF_CONF_HDR_SIZE 12 // default 0, 9 bytes with short addresses
+
 #define MAX_RX_SYNC_DISCOVERY 12
 #define RSSI_THRESHOLD -80
 #define IDLE_BROADCAST 1
@@ -90,6 +139,8 @@
 
 #define UTIL_PROACTIVE_SLOT 3
 #define NUM_CONS_SLOTS 5
+#define CSYNC_COLORING 0 // default 0, 1 to reuse consensus slots between clusters without a common CB
+#define CSYNC_COLORING_CONF_SLOTS 3 // slots per synchronization pass with CSYNC_COLORING
 #define POLITE_PROACTIVE_OFFSET ((CONS_CTRL_SLOT_INTERVAL / RTIMER_HF_SECOND) * CLOCK_SECOND) / 3
 #define NUM_CONS_CTRL_ITERATIONS 3
 
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2010, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Shell interface to the C-sync per-phase statistics and
+ *         sync-error histograms
+ *
+ *         The commands are meant to be run while C-sync keeps its
+ *         nodes in sync. The command line and the exit of each command
+ *         are broadcast to every process, c_gtsp_process only moves on
+ *         on its own polls and ignores them.
+ */
+
+#include "shell.h"
+#include "shell-csync.h"
+#include "net/c-sync/csync-phase.h"
+#include "net/c-sync/csync-hist.h"
+#include <stdio.h>
+#include <string.h>
+
+/*---------------------------------------------------------------------------*/
+PROCESS(shell_csync_phase_process, "csync-phase");
+SHELL_COMMAND(csync_phase_command,
+	      "csync-phase",
+	      "csync-phase [-b|-r]: per-phase energy and beacons of C-sync, -b binary (hex), -r reset",
+	      &shell_csync_phase_process);
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(shell_csync_phase_process, ev, data)
+{
+  const char *args = data;
+
+  PROCESS_BEGIN();
+
+  if(args != NULL && strncmp(args, "-b", 2) == 0) {
+    csync_phase_print_binary();
+  } else if(args != NULL && strncmp(args, "-r", 2) == 0) {
+    csync_phase_init();
+  } else {
+    csync_phase_print();
+  }
+  printf("\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+#if CSYNC_HIST
+PROCESS(shell_csync_hist_process, "csync-hist");
+SHELL_COMMAND(csync_hist_command,
+	      "csync-hist",
+	      "csync-hist [-b|-r]: sync-error histograms per neighbour and percentiles, -b binary (hex), -r reset",
+	      &shell_csync_hist_process);
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(shell_csync_hist_process, ev, data)
+{
+  const char *args = data;
+
+  PROCESS_BEGIN();
+
+  if(args != NULL && strncmp(args, "-b", 2) == 0) {
+    csync_hist_print_binary();
+  } else if(args != NULL && strncmp(args, "-r", 2) == 0) {
+    csync_hist_init();
+  } else {
+    csync_hist_print();
+    csync_hist_print_percentiles();
+  }
+  printf("\n");
+
+  PROCESS_END();
+}
+#endif /* CSYNC_HIST */
+/*---------------------------------------------------------------------------*/
+void
+shell_csync_init(void)
+{
+  shell_register_command(&csync_phase_command);
+#if CSYNC_HIST
+  shell_register_command(&csync_hist_command);
+#endif /* CSYNC_HIST */
+}
+/*---------------------------------------------------------------------------*/
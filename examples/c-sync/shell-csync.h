@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2005, Swedish Institute of Computer Science
+ * Copyright (c) 2010, Swedish Institute of Computer Science.
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -32,39 +32,13 @@
 
 /**
  * \file
- *         Header file for the real-time timer module.
- * \author
- *         Adam Dunkels <adam@sics.se>
- *
- */
-
-/** \addtogroup sys
- * @{ */
-
-/**
- * \defgroup rt Real-time task scheduling
- *
- * The real-time module handles the scheduling and execution of
- * real-time tasks (with predictable execution times).
- *
- * @{
+ *         Shell interface to the C-sync per-phase statistics and
+ *         sync-error histograms
  */
 
-#ifndef GTSP_H_
-#define GTSP_H_
-
-#include "contiki-conf.h"
-#include "net/rime/rime.h"
-#include "lib/list.h"
-#include "net/c-sync/c-sync.h"
-
-#define GTSP_JUMP_THRESHOLD 100
-
-#define GTSP_COARSE_OVERFLOW_THRESHOLD 1000
-#define GTSP_MOVING_ALPHA 0.9
-#define GTSP_DRIFT_THRESHOLD 0.001
+#ifndef SHELL_CSYNC_H
+#define SHELL_CSYNC_H
 
-/** @} */
-/** @} */
+void shell_csync_init(void);
 
-#endif /* GTSP_H_ */
\ No newline at end of file
+#endif /* SHELL_CSYNC_H */
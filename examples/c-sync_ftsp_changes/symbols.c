@@ -1,4 +0,0 @@
-#include "symbols.h"
-
-const int symbols_nelts = 0;
-const struct symbols symbols[] = {{0,0}};
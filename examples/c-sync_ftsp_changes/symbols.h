@@ -1,3 +0,0 @@
-#include "loader/symbols.h"
-
-extern const struct symbols symbols[1];
@@ -125,9 +125,14 @@
 
 #define WITH_ASCII 1
 
-#define PROCESS_CONF_NUMEVENTS 8
+#define PROCESS_CONF_NUMEVENTS 16
 #define PROCESS_CONF_STATS 1
 /*#define PROCESS_CONF_FASTPOLL    4*/
+/* Interrupts off around the poll queue, process_poll() is called from
+   the rtimer and radio interrupts */
+#define PROCESS_CONF_ATOMIC_DECL(s) spl_t s
+#define PROCESS_CONF_ATOMIC_BEGIN(s) ((s) = splhigh())
+#define PROCESS_CONF_ATOMIC_END(s) splx(s)
 
 #ifdef NETSTACK_CONF_WITH_IPV6
 
@@ -0,0 +1,70 @@
+/*
+ * Aggregation over the C-sync clusters, merged against forwarded. The
+ * same chain runs twice, out of radio range of each other: the motes of
+ * type agg1 merge the aggregates (CSYNC_AGG_CONF_MERGE 1), the motes of
+ * type agg0 forward every sample (0). The transmissions of the first
+ * ROUNDS rounds, summed from the "A r <round> ... tx" lines, are
+ * compared once both sinks are done with them. CMs never learn the
+ * round number, they send one sample per round in both modes and are
+ * left out of the sums. The test fails unless merging costs fewer
+ * transmissions and both sinks received samples.
+ */
+var ROUNDS = 3;
+
+var tx = { agg0: {}, agg1: {} };      /* "node round" -> tx of that round */
+var samples = { agg0: 0, agg1: 0 };   /* counted by the sink */
+var rounds = { agg0: 0, agg1: 0 };    /* results printed by the sink */
+
+TIMEOUT(600000, log.log("timeout, " + rounds.agg1 + " merged and " + rounds.agg0 + " forwarded rounds\n"); log.testFailed());
+
+function total(t) {
+  var sum = 0;
+  for(var k in t) {
+    sum += t[k];
+  }
+  return sum;
+}
+
+/* The other nodes print the stats of a round when the next one starts,
+   so wait for the sink to finish one more round */
+while(rounds.agg0 <= ROUNDS || rounds.agg1 <= ROUNDS) {
+  YIELD();
+
+  var type = mote.getType().getIdentifier();
+  if(tx[type] == undefined) {
+    continue;
+  }
+
+  var m = msg.match(/^(\d+) A r (\d+) h \d+ tx (\d+)/);
+  if(m != null) {
+    if(parseInt(m[2]) >= 1 && parseInt(m[2]) <= ROUNDS) {
+      tx[type][m[1] + " " + m[2]] = parseInt(m[3]);
+    }
+    continue;
+  }
+
+  m = msg.match(/^(\d+) AGG r (\d+) \S+ n (\d+)/);
+  if(m != null) {
+    rounds[type]++;
+    if(parseInt(m[2]) <= ROUNDS) {
+      samples[type] += parseInt(m[3]);
+    }
+  }
+}
+
+var merged = total(tx.agg1);
+var forwarded = total(tx.agg0);
+log.log("tx in " + ROUNDS + " rounds: merged " + merged + ", forwarded " + forwarded + "\n");
+log.log("samples at the sink: merged " + samples.agg1 + ", forwarded " + samples.agg0 + "\n");
+
+if(samples.agg1 == 0 || samples.agg0 == 0) {
+  log.log("FAIL: a sink received no samples\n");
+  log.testFailed();
+  return; /* the script runs inside a function, see ScriptParser */
+}
+if(merged >= forwarded) {
+  log.log("FAIL: merging did not save transmissions\n");
+  log.testFailed();
+  return;
+}
+log.testOK();
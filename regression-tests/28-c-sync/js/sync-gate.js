@@ -0,0 +1,130 @@
+/*
+ * Quantitative gates for the C-sync simulations. The topology is told
+ * apart by the number of motes. A test fails when
+ *  - a node needs longer than idle_ms to reach IDLE the first time,
+ *  - a node sends more than beacons announcements before its first IDLE
+ *    (decoded from the per-phase PB record),
+ *  - once every node is IDLE, any GTSP (fd) or consensus (sync C) offset
+ *    between two neighbours exceeds offset rtimer ticks,
+ *  - a node dropped log bytes (TX d, UART1_CONF_TX_DROP), since the
+ *    checks above would then miss lines.
+ * The limits are loose on purpose, tighten them as the engine improves.
+ */
+var limits = {
+  37: { name: "full",      idle_ms: 120000, offset: 1000, beacons: 200 },
+  11: { name: "chain",     idle_ms: 120000, offset: 1000, beacons: 150 },
+  9:  { name: "byzantine", idle_ms: 150000, offset: 2000, beacons: 250 }
+};
+var OBSERVE_US = 60000000; /* offsets are checked for 60 s after all are IDLE */
+var PB_RECORD_LEN = 27;    /* CSYNC_PHASE_RECORD_LEN */
+var PB_SENT_OFFSET = 23;   /* beacons_sent in the record */
+
+TIMEOUT(400000, log.log("timeout, " + idle_count + " of " + nodes + " nodes reached IDLE\n"); log.testFailed());
+
+var nodes = sim.getMotesCount();
+var l = limits[nodes];
+var idle = {};
+var idle_count = 0;
+var idle_last = 0;
+var beacons = {};
+var offset_max = 0;
+var offset_pair = "-";
+var observe_until = -1;
+var failed = false;
+
+if(l == undefined) {
+  log.log("no limits for a topology with " + nodes + " motes\n");
+  log.testFailed();
+  return; /* the script runs inside a function, see ScriptParser */
+}
+log.log("topology " + l.name + " with " + nodes + " motes\n");
+
+function fail(reason) {
+  log.log("FAIL: " + reason + "\n");
+  failed = true;
+}
+
+function check_offset(node, neighbour, offset) {
+  if(observe_until < 0) {
+    return;
+  }
+  if(offset < 0) {
+    offset = -offset;
+  }
+  if(offset > offset_max) {
+    offset_max = offset;
+    offset_pair = node + "-" + neighbour;
+  }
+  if(offset > l.offset) {
+    fail("offset " + offset + " between " + node + " and " + neighbour + " at " + time);
+  }
+}
+
+function beacons_sent(hex) {
+  var sent = 0;
+  var i, lo, hi;
+  for(i = 0; i + 2 * PB_RECORD_LEN <= hex.length; i += 2 * PB_RECORD_LEN) {
+    lo = parseInt(hex.substr(i + 2 * PB_SENT_OFFSET, 2), 16);
+    hi = parseInt(hex.substr(i + 2 * PB_SENT_OFFSET + 2, 2), 16);
+    sent += lo + 256 * hi;
+  }
+  return sent;
+}
+
+while(observe_until < 0 || time < observe_until) {
+  YIELD();
+
+  if(msg.indexOf("-> I") >= 0 && idle[id] == undefined) {
+    idle[id] = time;
+    idle_count++;
+    idle_last = time;
+    if(time / 1000 > l.idle_ms) {
+      fail("node " + id + " reached IDLE after " + (time / 1000) + " ms");
+    }
+    if(idle_count == nodes) {
+      log.log("all nodes IDLE after " + (time / 1000) + " ms\n");
+      observe_until = time + OBSERVE_US;
+    }
+    continue;
+  }
+
+  var m = msg.match(/^(\d+) PB ([0-9a-f]*)/);
+  if(m != null && beacons[id] == undefined) {
+    beacons[id] = beacons_sent(m[2]);
+    if(beacons[id] > l.beacons) {
+      fail("node " + id + " sent " + beacons[id] + " beacons before IDLE");
+    }
+    continue;
+  }
+
+  m = msg.match(/^(\d+) TX d (\d+)/);
+  if(m != null) {
+    if(parseInt(m[2]) > 0) {
+      fail("node " + id + " dropped " + m[2] + " log bytes");
+    }
+    continue;
+  }
+
+  m = msg.match(/^(\d+) \d+ N (\d+) fd (-?\d+)/);
+  if(m != null) {
+    check_offset(m[1], m[2], parseInt(m[3]));
+    continue;
+  }
+
+  m = msg.match(/sync C (\d+), N (\d+) @ (-?\d+)/);
+  if(m != null) {
+    check_offset(id, m[2], parseInt(m[3]));
+  }
+}
+
+var total = 0;
+for(var n in beacons) {
+  total += beacons[n];
+}
+log.log("time to IDLE " + (idle_last / 1000) + " ms, max offset " + offset_max +
+        " (" + offset_pair + "), beacons " + total + "\n");
+
+if(failed) {
+  log.testFailed();
+}
+log.testOK();
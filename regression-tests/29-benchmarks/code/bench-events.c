@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the normal and real-time event queues
+ *
+ *         Prints the time spent in process_post() and process_post_rt()
+ *         and in delivering the events, in rtimer_now_fine() ticks, and
+ *         checks that real-time events are delivered first and that
+ *         overflows and high-water marks are counted.
+ */
+
+#include "contiki.h"
+#include "bench.h"
+
+#define BENCH_EVENT_NORMAL 1
+#define BENCH_EVENT_RT     2
+
+PROCESS(bench_process, "event queue benchmark");
+PROCESS(sink_process, "event sink");
+AUTOSTART_PROCESSES(&bench_process);
+
+static process_event_t received[PROCESS_CONF_NUMEVENTS + PROCESS_CONF_NUMEVENTS_RT];
+static uint8_t nreceived;
+
+/*---------------------------------------------------------------------------*/
+/* process_run() is called from within bench_process, which the scheduler
+   does not restore afterwards */
+static void
+run_all(void)
+{
+  struct process *self = PROCESS_CURRENT();
+
+  while(process_run() > 0);
+  process_current = self;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(sink_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  while(1) {
+    PROCESS_YIELD();
+    if(ev == BENCH_EVENT_NORMAL || ev == BENCH_EVENT_RT) {
+      if(nreceived < sizeof(received) / sizeof(received[0])) {
+        received[nreceived++] = ev;
+      }
+    }
+  }
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_normal, "Normal");
+UNIT_TEST(test_normal)
+{
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  nreceived = 0;
+  bench_begin();
+  for(i = 0; i < PROCESS_CONF_NUMEVENTS; i++) {
+    process_post(&sink_process, BENCH_EVENT_NORMAL, NULL);
+  }
+  bench_end("process_post", PROCESS_CONF_NUMEVENTS);
+
+  bench_begin();
+  run_all();
+  bench_end("deliver normal", PROCESS_CONF_NUMEVENTS);
+
+  UNIT_TEST_ASSERT(nreceived == PROCESS_CONF_NUMEVENTS);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_rt, "Real-time");
+UNIT_TEST(test_rt)
+{
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  nreceived = 0;
+  bench_begin();
+  for(i = 0; i < PROCESS_CONF_NUMEVENTS_RT; i++) {
+    process_post_rt(&sink_process, BENCH_EVENT_RT, NULL);
+  }
+  bench_end("process_post_rt", PROCESS_CONF_NUMEVENTS_RT);
+
+  bench_begin();
+  run_all();
+  bench_end("deliver rt", PROCESS_CONF_NUMEVENTS_RT);
+
+  UNIT_TEST_ASSERT(nreceived == PROCESS_CONF_NUMEVENTS_RT);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_order, "Order");
+UNIT_TEST(test_order)
+{
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  /* Normal events first, real-time events must still overtake them */
+  nreceived = 0;
+  for(i = 0; i < PROCESS_CONF_NUMEVENTS; i++) {
+    process_post(&sink_process, BENCH_EVENT_NORMAL, NULL);
+  }
+  for(i = 0; i < PROCESS_CONF_NUMEVENTS_RT; i++) {
+    process_post_rt(&sink_process, BENCH_EVENT_RT, NULL);
+  }
+  run_all();
+
+  UNIT_TEST_ASSERT(nreceived == PROCESS_CONF_NUMEVENTS + PROCESS_CONF_NUMEVENTS_RT);
+  for(i = 0; i < PROCESS_CONF_NUMEVENTS_RT; i++) {
+    UNIT_TEST_ASSERT(received[i] == BENCH_EVENT_RT);
+  }
+  for(; i < nreceived; i++) {
+    UNIT_TEST_ASSERT(received[i] == BENCH_EVENT_NORMAL);
+  }
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+#if PROCESS_CONF_STATS
+UNIT_TEST_REGISTER(test_overflow, "Overflow");
+UNIT_TEST(test_overflow)
+{
+  unsigned short overflows = process_overflows;
+  unsigned short overflows_rt = process_overflows_rt;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  for(i = 0; i < PROCESS_CONF_NUMEVENTS; i++) {
+    process_post(&sink_process, BENCH_EVENT_NORMAL, NULL);
+  }
+  for(i = 0; i < PROCESS_CONF_NUMEVENTS_RT; i++) {
+    process_post_rt(&sink_process, BENCH_EVENT_RT, NULL);
+  }
+  UNIT_TEST_ASSERT(process_post(&sink_process, BENCH_EVENT_NORMAL, NULL) == PROCESS_ERR_FULL);
+  UNIT_TEST_ASSERT(process_post_rt(&sink_process, BENCH_EVENT_RT, NULL) == PROCESS_ERR_FULL);
+  run_all();
+
+  UNIT_TEST_ASSERT(process_overflows > overflows);
+  UNIT_TEST_ASSERT(process_overflows_rt > overflows_rt);
+  UNIT_TEST_ASSERT(process_maxevents == PROCESS_CONF_NUMEVENTS);
+  UNIT_TEST_ASSERT(process_maxevents_rt == PROCESS_CONF_NUMEVENTS_RT);
+
+  UNIT_TEST_END();
+}
+#endif /* PROCESS_CONF_STATS */
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(bench_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  bench_init();
+
+  process_start(&sink_process, NULL);
+  /* Let the other processes settle before the queues are filled */
+  run_all();
+
+  UNIT_TEST_RUN(test_normal);
+  UNIT_TEST_RUN(test_rt);
+  UNIT_TEST_RUN(test_order);
+#if PROCESS_CONF_STATS
+  UNIT_TEST_RUN(test_overflow);
+#endif
+
+  bench_done();
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
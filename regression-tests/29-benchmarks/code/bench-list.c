@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the singly and doubly linked list libraries
+ *
+ *         Uses BENCH_ITEMS items as a queue with both libraries,
+ *         appending at the tail and removing from the head, the tail
+ *         and the middle, prints the time spent per call in
+ *         rtimer_now_fine() ticks and checks that the doubly linked
+ *         list keeps the same order.
+ */
+
+#include "contiki.h"
+#include "lib/list.h"
+#include "lib/dlist.h"
+#include "bench.h"
+
+#ifndef BENCH_ITEMS
+#define BENCH_ITEMS 64
+#endif
+
+struct bench_item {
+  struct bench_item *next;
+  struct bench_item *prev;
+  uint16_t seq;
+};
+
+PROCESS(bench_process, "list benchmark");
+AUTOSTART_PROCESSES(&bench_process);
+
+LIST(queue);
+DLIST(dqueue);
+
+static struct bench_item items[BENCH_ITEMS];
+
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_list, "List");
+UNIT_TEST(test_list)
+{
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  list_init(queue);
+  bench_begin();
+  for(i = 0; i < BENCH_ITEMS; i++) {
+    list_add(queue, &items[i]);
+  }
+  bench_end("list_add", BENCH_ITEMS);
+
+  bench_begin();
+  for(i = 0; i < BENCH_ITEMS / 2; i++) {
+    list_remove(queue, &items[BENCH_ITEMS / 2 + i]);
+  }
+  bench_end("list_remove", BENCH_ITEMS / 2);
+
+  bench_begin();
+  for(i = 0; i < BENCH_ITEMS / 2; i++) {
+    list_chop(queue);
+  }
+  bench_end("list_chop", BENCH_ITEMS / 2);
+
+  UNIT_TEST_ASSERT(list_length(queue) == 0);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_dlist, "Dlist");
+UNIT_TEST(test_dlist)
+{
+  struct bench_item *item;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  dlist_init(dqueue);
+  bench_begin();
+  for(i = 0; i < BENCH_ITEMS; i++) {
+    items[i].seq = i;
+    dlist_add(dqueue, &items[i]);
+  }
+  bench_end("dlist_add", BENCH_ITEMS);
+
+  UNIT_TEST_ASSERT(dlist_length(dqueue) == BENCH_ITEMS);
+  UNIT_TEST_ASSERT(dlist_tail(dqueue) == &items[BENCH_ITEMS - 1]);
+
+  /* Every other item, from the middle of the list */
+  bench_begin();
+  for(i = 1; i < BENCH_ITEMS; i += 2) {
+    dlist_remove(dqueue, &items[i]);
+  }
+  bench_end("dlist_remove", BENCH_ITEMS / 2);
+
+  /* Still in order, forwards and backwards */
+  i = 0;
+  for(item = dlist_head(dqueue); item != NULL; item = list_item_next(item)) {
+    UNIT_TEST_ASSERT(item->seq == i);
+    i += 2;
+  }
+  for(item = dlist_tail(dqueue); item != NULL; item = dlist_item_prev(item)) {
+    i -= 2;
+    UNIT_TEST_ASSERT(item->seq == i);
+  }
+
+  bench_begin();
+  for(i = 0; i < BENCH_ITEMS / 4; i++) {
+    dlist_chop(dqueue);
+    dlist_pop(dqueue);
+  }
+  bench_end("dlist_chop+dlist_pop", BENCH_ITEMS / 2);
+
+  UNIT_TEST_ASSERT(dlist_length(dqueue) == 0);
+  UNIT_TEST_ASSERT(dlist_head(dqueue) == NULL);
+  UNIT_TEST_ASSERT(dlist_tail(dqueue) == NULL);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(bench_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  bench_init();
+
+  UNIT_TEST_RUN(test_list);
+  UNIT_TEST_RUN(test_dlist);
+
+  bench_done();
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
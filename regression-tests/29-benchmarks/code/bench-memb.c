@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the memb block allocator
+ *
+ *         Allocates and frees every block of a pool as large as the
+ *         neighbour pool of C-sync (MAX_DEGREE), prints the time spent
+ *         per call in rtimer_now_fine() ticks, and checks that blocks
+ *         are handed out once and counted by memb_numfree().
+ */
+
+#include "contiki.h"
+#include "lib/memb.h"
+#include "lib/random.h"
+#include "bench.h"
+
+#ifndef BENCH_BLOCKS
+#define BENCH_BLOCKS 64 /* MAX_DEGREE */
+#endif
+
+struct bench_block {
+  uint16_t addr;
+  uint8_t data[30];
+};
+
+PROCESS(bench_process, "memb benchmark");
+AUTOSTART_PROCESSES(&bench_process);
+
+MEMB(bench_memb, struct bench_block, BENCH_BLOCKS);
+
+static struct bench_block *blocks[BENCH_BLOCKS];
+
+/*---------------------------------------------------------------------------*/
+static int
+distinct(void)
+{
+  int i, j;
+
+  for(i = 0; i < BENCH_BLOCKS; i++) {
+    if(blocks[i] == NULL || !memb_inmemb(&bench_memb, blocks[i])) {
+      return 0;
+    }
+    for(j = 0; j < i; j++) {
+      if(blocks[i] == blocks[j]) {
+        return 0;
+      }
+    }
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_alloc, "Alloc");
+UNIT_TEST(test_alloc)
+{
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  memb_init(&bench_memb);
+
+  bench_begin();
+  for(i = 0; i < BENCH_BLOCKS; i++) {
+    blocks[i] = memb_alloc(&bench_memb);
+  }
+  bench_end("memb_alloc", BENCH_BLOCKS);
+
+  UNIT_TEST_ASSERT(distinct());
+  UNIT_TEST_ASSERT(memb_numfree(&bench_memb) == 0);
+  UNIT_TEST_ASSERT(memb_alloc(&bench_memb) == NULL);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_free, "Free");
+UNIT_TEST(test_free)
+{
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  /* The last blocks were the slowest to find and to free */
+  bench_begin();
+  for(i = BENCH_BLOCKS - 1; i >= 0; i--) {
+    memb_free(&bench_memb, blocks[i]);
+  }
+  bench_end("memb_free", BENCH_BLOCKS);
+
+  UNIT_TEST_ASSERT(memb_numfree(&bench_memb) == BENCH_BLOCKS);
+  UNIT_TEST_ASSERT(memb_free(&bench_memb, blocks[0]) == 0);
+  UNIT_TEST_ASSERT(memb_numfree(&bench_memb) == BENCH_BLOCKS);
+  UNIT_TEST_ASSERT(memb_free(&bench_memb, (char *)blocks[0] + 1) == -1);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_churn, "Churn");
+UNIT_TEST(test_churn)
+{
+  int i, j;
+  int used = 0;
+
+  UNIT_TEST_BEGIN();
+
+  for(i = 0; i < BENCH_BLOCKS; i++) {
+    blocks[i] = NULL;
+  }
+
+  /* Neighbours come and go in any order */
+  bench_begin();
+  for(i = 0; i < 8 * BENCH_BLOCKS; i++) {
+    j = random_rand() % BENCH_BLOCKS;
+    if(blocks[j] == NULL) {
+      blocks[j] = memb_alloc(&bench_memb);
+      used++;
+    } else {
+      memb_free(&bench_memb, blocks[j]);
+      blocks[j] = NULL;
+      used--;
+    }
+  }
+  bench_end("memb_alloc/memb_free", 8 * BENCH_BLOCKS);
+
+  UNIT_TEST_ASSERT(memb_numfree(&bench_memb) == BENCH_BLOCKS - used);
+
+  for(i = 0; i < BENCH_BLOCKS; i++) {
+    if(blocks[i] == NULL) {
+      blocks[i] = memb_alloc(&bench_memb);
+    }
+  }
+  UNIT_TEST_ASSERT(distinct());
+  UNIT_TEST_ASSERT(memb_numfree(&bench_memb) == 0);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(bench_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  bench_init();
+
+  UNIT_TEST_RUN(test_alloc);
+  UNIT_TEST_RUN(test_free);
+  UNIT_TEST_RUN(test_churn);
+
+  bench_done();
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the managed memory allocator
+ *
+ *         Frees blocks from the bottom of the managed memory, which
+ *         used to move every block above them, prints the time spent
+ *         in mmem_free(), mmem_alloc() and mmem_compact() in
+ *         rtimer_now_fine() ticks, and checks that the content of the
+ *         blocks survives compaction.
+ */
+
+#include <string.h>
+
+#include "contiki.h"
+#include "lib/mmem.h"
+#include "bench.h"
+
+#define BENCH_BLOCKS 16
+#define BENCH_SIZE   64
+
+PROCESS(bench_process, "mmem benchmark");
+AUTOSTART_PROCESSES(&bench_process);
+
+static struct mmem blocks[BENCH_BLOCKS];
+
+/*---------------------------------------------------------------------------*/
+static int
+intact(int from)
+{
+  int i, j;
+
+  for(i = from; i < BENCH_BLOCKS; i++) {
+    for(j = 0; j < BENCH_SIZE; j++) {
+      if(((uint8_t *)MMEM_PTR(&blocks[i]))[j] != i) {
+        return 0;
+      }
+    }
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_alloc, "Alloc");
+UNIT_TEST(test_alloc)
+{
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  bench_begin();
+  for(i = 0; i < BENCH_BLOCKS; i++) {
+    mmem_alloc(&blocks[i], BENCH_SIZE);
+  }
+  bench_end("mmem_alloc", BENCH_BLOCKS);
+
+  for(i = 0; i < BENCH_BLOCKS; i++) {
+    memset(MMEM_PTR(&blocks[i]), i, BENCH_SIZE);
+  }
+
+  UNIT_TEST_ASSERT(mmem_get_stats()->used == BENCH_BLOCKS * BENCH_SIZE);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_free, "Free");
+UNIT_TEST(test_free)
+{
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  /* Lowest blocks first, the worst case of a compacting free */
+  bench_begin();
+  for(i = 0; i < BENCH_BLOCKS / 2; i++) {
+    mmem_free(&blocks[i]);
+  }
+  bench_end("mmem_free", BENCH_BLOCKS / 2);
+
+  UNIT_TEST_ASSERT(intact(BENCH_BLOCKS / 2));
+  UNIT_TEST_ASSERT(mmem_get_stats()->used == BENCH_BLOCKS / 2 * BENCH_SIZE);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_compact, "Compact");
+UNIT_TEST(test_compact)
+{
+  int steps = 0;
+
+  UNIT_TEST_BEGIN();
+
+  /* One block per step */
+  bench_begin();
+  while(!mmem_compact(BENCH_SIZE)) {
+    steps++;
+  }
+  bench_end("mmem_compact", steps + 1);
+
+  UNIT_TEST_ASSERT(steps + 1 == BENCH_BLOCKS / 2);
+  UNIT_TEST_ASSERT(intact(BENCH_BLOCKS / 2));
+  UNIT_TEST_ASSERT(mmem_get_stats()->moved == BENCH_BLOCKS / 2 * BENCH_SIZE);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(bench_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  bench_init();
+
+  mmem_init();
+
+  UNIT_TEST_RUN(test_alloc);
+  UNIT_TEST_RUN(test_free);
+  UNIT_TEST_RUN(test_compact);
+
+  bench_done();
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
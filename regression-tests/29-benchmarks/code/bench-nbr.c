@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the link-layer neighbor table lookups
+ *
+ *         Fills a neighbor table with NBR_TABLE_MAX_NEIGHBORS entries
+ *         and prints the time spent per nbr_table_get_from_lladdr()
+ *         call in rtimer_now_fine() ticks, for present and absent
+ *         addresses, next to a linear walk over the table as done
+ *         before the address hash. Also checks that lookups follow
+ *         nbr_table_update_lladdr() and the removal of neighbors.
+ */
+
+#include "contiki.h"
+#include "net/nbr-table.h"
+#include "bench.h"
+
+#ifndef BENCH_ROUNDS
+#define BENCH_ROUNDS 16
+#endif
+
+struct bench_nbr {
+  uint16_t seq;
+};
+
+PROCESS(bench_process, "neighbor table benchmark");
+AUTOSTART_PROCESSES(&bench_process);
+
+NBR_TABLE(struct bench_nbr, bench_nbrs);
+
+/*---------------------------------------------------------------------------*/
+/* Addresses as in a large network: node ids spread over the last bytes */
+static void
+bench_lladdr(linkaddr_t *lladdr, uint16_t id)
+{
+  linkaddr_copy(lladdr, &linkaddr_null);
+  lladdr->u8[LINKADDR_SIZE - 1] = id & 0xff;
+  lladdr->u8[LINKADDR_SIZE - 2] = id >> 8;
+}
+/*---------------------------------------------------------------------------*/
+static struct bench_nbr *
+linear_lookup(const linkaddr_t *lladdr)
+{
+  struct bench_nbr *nbr;
+
+  for(nbr = nbr_table_head(bench_nbrs); nbr != NULL;
+      nbr = nbr_table_next(bench_nbrs, nbr)) {
+    if(linkaddr_cmp(lladdr, nbr_table_get_lladdr(bench_nbrs, nbr))) {
+      return nbr;
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_fill, "Fill");
+UNIT_TEST(test_fill)
+{
+  struct bench_nbr *nbr;
+  linkaddr_t lladdr;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  bench_begin();
+  for(i = 0; i < NBR_TABLE_MAX_NEIGHBORS; i++) {
+    bench_lladdr(&lladdr, 100 + 7 * i);
+    nbr = nbr_table_add_lladdr(bench_nbrs, &lladdr, NBR_TABLE_REASON_UNDEFINED, NULL);
+    UNIT_TEST_ASSERT(nbr != NULL);
+    nbr->seq = i;
+  }
+  bench_end("nbr_table_add_lladdr", NBR_TABLE_MAX_NEIGHBORS);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_lookup, "Lookup");
+UNIT_TEST(test_lookup)
+{
+  struct bench_nbr *nbr;
+  linkaddr_t lladdr;
+  int i;
+  int r;
+
+  UNIT_TEST_BEGIN();
+
+  /* Every neighbor, as when each received packet is looked up */
+  for(i = 0; i < NBR_TABLE_MAX_NEIGHBORS; i++) {
+    bench_lladdr(&lladdr, 100 + 7 * i);
+    nbr = nbr_table_get_from_lladdr(bench_nbrs, &lladdr);
+    UNIT_TEST_ASSERT(nbr != NULL && nbr->seq == i);
+    UNIT_TEST_ASSERT(linear_lookup(&lladdr) == nbr);
+  }
+
+  bench_lladdr(&lladdr, 100 + 7 * (NBR_TABLE_MAX_NEIGHBORS - 1));
+  bench_begin();
+  for(r = 0; r < BENCH_ROUNDS; r++) {
+    nbr = linear_lookup(&lladdr);
+  }
+  bench_end("linear-last", BENCH_ROUNDS);
+
+  bench_begin();
+  for(r = 0; r < BENCH_ROUNDS; r++) {
+    nbr = nbr_table_get_from_lladdr(bench_nbrs, &lladdr);
+  }
+  bench_end("nbr_table_get_from_lladdr-last", BENCH_ROUNDS);
+  UNIT_TEST_ASSERT(nbr != NULL);
+
+  /* Packets from nodes that are not neighbors */
+  bench_lladdr(&lladdr, 3);
+  bench_begin();
+  for(r = 0; r < BENCH_ROUNDS; r++) {
+    nbr = nbr_table_get_from_lladdr(bench_nbrs, &lladdr);
+  }
+  bench_end("nbr_table_get_from_lladdr-miss", BENCH_ROUNDS);
+  UNIT_TEST_ASSERT(nbr == NULL);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_update, "Update");
+UNIT_TEST(test_update)
+{
+  struct bench_nbr *nbr;
+  linkaddr_t old_lladdr;
+  linkaddr_t new_lladdr;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  bench_begin();
+  for(i = 0; i < NBR_TABLE_MAX_NEIGHBORS; i++) {
+    bench_lladdr(&old_lladdr, 100 + 7 * i);
+    bench_lladdr(&new_lladdr, 1000 + i);
+    UNIT_TEST_ASSERT(nbr_table_update_lladdr(&old_lladdr, &new_lladdr, 0));
+  }
+  bench_end("nbr_table_update_lladdr", NBR_TABLE_MAX_NEIGHBORS);
+
+  for(i = 0; i < NBR_TABLE_MAX_NEIGHBORS; i++) {
+    bench_lladdr(&old_lladdr, 100 + 7 * i);
+    bench_lladdr(&new_lladdr, 1000 + i);
+    UNIT_TEST_ASSERT(nbr_table_get_from_lladdr(bench_nbrs, &old_lladdr) == NULL);
+    nbr = nbr_table_get_from_lladdr(bench_nbrs, &new_lladdr);
+    UNIT_TEST_ASSERT(nbr != NULL && nbr->seq == i);
+  }
+
+  /* Removed from the table, not found any more */
+  for(i = 0; i < NBR_TABLE_MAX_NEIGHBORS; i += 2) {
+    bench_lladdr(&new_lladdr, 1000 + i);
+    nbr_table_remove(bench_nbrs, nbr_table_get_from_lladdr(bench_nbrs, &new_lladdr));
+  }
+  for(i = 0; i < NBR_TABLE_MAX_NEIGHBORS; i++) {
+    bench_lladdr(&new_lladdr, 1000 + i);
+    nbr = nbr_table_get_from_lladdr(bench_nbrs, &new_lladdr);
+    UNIT_TEST_ASSERT((nbr == NULL) == ((i & 1) == 0));
+  }
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(bench_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  bench_init();
+
+  nbr_table_register(bench_nbrs, NULL);
+
+  UNIT_TEST_RUN(test_fill);
+  UNIT_TEST_RUN(test_lookup);
+  UNIT_TEST_RUN(test_update);
+
+  bench_done();
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
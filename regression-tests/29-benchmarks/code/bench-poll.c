@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the poll dispatch of the process scheduler
+ *
+ *         Starts BENCH_PROCESSES processes that only wait for polls,
+ *         prints the time spent in process_run() when nothing is
+ *         pending and when a single process is polled, in
+ *         rtimer_now_fine() ticks, and checks that every poll is
+ *         delivered once and in order.
+ */
+
+#include <stdio.h>
+
+#include "contiki.h"
+#include "bench.h"
+
+#ifndef BENCH_PROCESSES
+#define BENCH_PROCESSES 24
+#endif
+
+#define BENCH_RUNS 256
+
+PROCESS(bench_process, "poll dispatch benchmark");
+AUTOSTART_PROCESSES(&bench_process);
+
+static struct process dummies[BENCH_PROCESSES];
+static uint16_t polled[BENCH_PROCESSES];
+static uint8_t order[BENCH_PROCESSES];
+static uint8_t norder;
+
+/*---------------------------------------------------------------------------*/
+/* process_run() is called from within bench_process, which the scheduler
+   does not restore afterwards */
+static void
+run(void)
+{
+  struct process *self = PROCESS_CURRENT();
+
+  process_run();
+  process_current = self;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(dummy_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  while(1) {
+    PROCESS_YIELD();
+    if(ev == PROCESS_EVENT_POLL) {
+      polled[PROCESS_CURRENT() - dummies]++;
+      if(norder < BENCH_PROCESSES) {
+        order[norder++] = PROCESS_CURRENT() - dummies;
+      }
+    }
+  }
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+static void
+clear(void)
+{
+  int i;
+
+  for(i = 0; i < BENCH_PROCESSES; i++) {
+    polled[i] = 0;
+  }
+  norder = 0;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_idle, "Idle");
+UNIT_TEST(test_idle)
+{
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  clear();
+  bench_begin();
+  for(i = 0; i < BENCH_RUNS; i++) {
+    run();
+  }
+  bench_end("process_run idle", BENCH_RUNS);
+
+  UNIT_TEST_ASSERT(norder == 0);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_poll_one, "Poll one");
+UNIT_TEST(test_poll_one)
+{
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  /* The first process started is at the end of the process list */
+  clear();
+  bench_begin();
+  for(i = 0; i < BENCH_RUNS; i++) {
+    process_poll(&dummies[0]);
+    run();
+  }
+  bench_end("process_poll+process_run", BENCH_RUNS);
+
+  UNIT_TEST_ASSERT(polled[0] == BENCH_RUNS);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_order, "Order");
+UNIT_TEST(test_order)
+{
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  /* Polling twice before the scheduler runs is delivered once */
+  clear();
+  process_poll(&dummies[5]);
+  process_poll(&dummies[3]);
+  process_poll(&dummies[BENCH_PROCESSES - 1]);
+  process_poll(&dummies[3]);
+  run();
+
+  UNIT_TEST_ASSERT(norder == 3);
+  UNIT_TEST_ASSERT(polled[3] == 1);
+#if PROCESS_POLL_QUEUE
+  UNIT_TEST_ASSERT(order[0] == 5);
+  UNIT_TEST_ASSERT(order[1] == 3);
+  UNIT_TEST_ASSERT(order[2] == BENCH_PROCESSES - 1);
+#endif
+
+  /* Every process polled at once */
+  clear();
+  bench_begin();
+  for(i = 0; i < BENCH_PROCESSES; i++) {
+    process_poll(&dummies[i]);
+  }
+  run();
+  bench_end("process_poll all+process_run", BENCH_PROCESSES);
+
+  for(i = 0; i < BENCH_PROCESSES; i++) {
+    UNIT_TEST_ASSERT(polled[i] == 1);
+  }
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_exited, "Exited");
+UNIT_TEST(test_exited)
+{
+  UNIT_TEST_BEGIN();
+
+  /* A process that exits while it is queued is not called */
+  clear();
+  process_poll(&dummies[7]);
+  process_exit(&dummies[7]);
+  run();
+
+  UNIT_TEST_ASSERT(polled[7] == 0);
+  UNIT_TEST_ASSERT(!process_is_running(&dummies[7]));
+
+  /* and can be started and polled again */
+  process_start(&dummies[7], NULL);
+  process_poll(&dummies[7]);
+  run();
+
+  UNIT_TEST_ASSERT(polled[7] == 1);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(bench_process, ev, data)
+{
+  static int i;
+
+  PROCESS_BEGIN();
+
+  bench_init();
+
+  for(i = 0; i < BENCH_PROCESSES; i++) {
+#if !PROCESS_CONF_NO_PROCESS_NAMES
+    dummies[i].name = "dummy";
+#endif
+    dummies[i].thread = process_thread_dummy_process;
+    process_start(&dummies[i], NULL);
+  }
+  printf("bench poll queue %u processes %u\n", PROCESS_POLL_QUEUE, BENCH_PROCESSES);
+
+  UNIT_TEST_RUN(test_idle);
+  UNIT_TEST_RUN(test_poll_one);
+  UNIT_TEST_RUN(test_order);
+  UNIT_TEST_RUN(test_exited);
+
+  bench_done();
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
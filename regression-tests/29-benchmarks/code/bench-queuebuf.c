@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the transmission of queued frames
+ *
+ *         Queues BENCH_FRAMES frames and hands each one to the
+ *         packetbuf BENCH_ROUNDS times with a MAC header in front, as
+ *         the RDC does for every CSMA transmission attempt. Prints the
+ *         time spent per frame in rtimer_now_fine() ticks when the
+ *         frame is copied (queuebuf_to_packetbuf()) and when it is
+ *         viewed in place (queuebuf_to_packetbuf_view()), and checks
+ *         that the queued frames are not modified.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "contiki.h"
+#include "net/packetbuf.h"
+#include "net/queuebuf.h"
+#include "bench.h"
+
+#ifndef BENCH_FRAMES
+#define BENCH_FRAMES 4
+#endif
+
+#ifndef BENCH_ROUNDS
+#define BENCH_ROUNDS 4
+#endif
+
+#define BENCH_LEN    100
+#define BENCH_HDRLEN 9 /* 802.15.4 header with short addresses */
+
+PROCESS(bench_process, "queuebuf benchmark");
+AUTOSTART_PROCESSES(&bench_process);
+
+static struct queuebuf *frames[BENCH_FRAMES];
+
+/*---------------------------------------------------------------------------*/
+/* What the framer does with the packetbuf before the radio sends it */
+static int
+bench_add_header(void)
+{
+  if(!packetbuf_hdralloc(BENCH_HDRLEN)) {
+    return 0;
+  }
+  memset(packetbuf_hdrptr(), 0x41, BENCH_HDRLEN);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+bench_frame_ok(int i)
+{
+  uint8_t *data = queuebuf_dataptr(frames[i]);
+  int j;
+
+  if(queuebuf_datalen(frames[i]) != BENCH_LEN) {
+    return 0;
+  }
+  for(j = 0; j < BENCH_LEN; j++) {
+    if(data[j] != (uint8_t)(i + j)) {
+      return 0;
+    }
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_queue, "Queue");
+UNIT_TEST(test_queue)
+{
+  uint8_t *data;
+  int i;
+  int j;
+
+  UNIT_TEST_BEGIN();
+
+  bench_begin();
+  for(i = 0; i < BENCH_FRAMES; i++) {
+    packetbuf_clear();
+    data = packetbuf_dataptr();
+    for(j = 0; j < BENCH_LEN; j++) {
+      data[j] = i + j;
+    }
+    packetbuf_set_datalen(BENCH_LEN);
+    packetbuf_set_attr(PACKETBUF_ATTR_MAC_SEQNO, i);
+    frames[i] = queuebuf_new_from_packetbuf();
+    UNIT_TEST_ASSERT(frames[i] != NULL);
+  }
+  bench_end("queuebuf_new_from_packetbuf", BENCH_FRAMES);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_copy, "Copy");
+UNIT_TEST(test_copy)
+{
+  int i;
+  int r;
+
+  UNIT_TEST_BEGIN();
+
+  bench_begin();
+  for(r = 0; r < BENCH_ROUNDS; r++) {
+    for(i = 0; i < BENCH_FRAMES; i++) {
+      queuebuf_to_packetbuf(frames[i]);
+      UNIT_TEST_ASSERT(bench_add_header());
+    }
+  }
+  bench_end("queuebuf_to_packetbuf+hdralloc", BENCH_ROUNDS * BENCH_FRAMES);
+
+  UNIT_TEST_ASSERT(packetbuf_totlen() == BENCH_LEN + BENCH_HDRLEN);
+  for(i = 0; i < BENCH_FRAMES; i++) {
+    UNIT_TEST_ASSERT(bench_frame_ok(i));
+  }
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_view, "View");
+UNIT_TEST(test_view)
+{
+  int i;
+  int r;
+
+  UNIT_TEST_BEGIN();
+
+  printf("bench headroom %u\n", QUEUEBUF_HDR_SIZE);
+
+  bench_begin();
+  for(r = 0; r < BENCH_ROUNDS; r++) {
+    for(i = 0; i < BENCH_FRAMES; i++) {
+      queuebuf_to_packetbuf_view(frames[i]);
+      UNIT_TEST_ASSERT(bench_add_header());
+    }
+  }
+  bench_end("queuebuf_to_packetbuf_view+hdralloc", BENCH_ROUNDS * BENCH_FRAMES);
+
+  /* The packetbuf sees the whole frame, the queued frames are intact */
+  UNIT_TEST_ASSERT(packetbuf_totlen() == BENCH_LEN + BENCH_HDRLEN);
+  UNIT_TEST_ASSERT(((uint8_t *)packetbuf_hdrptr())[0] == 0x41);
+  UNIT_TEST_ASSERT(((uint8_t *)packetbuf_dataptr())[0] == BENCH_FRAMES - 1);
+  UNIT_TEST_ASSERT(packetbuf_attr(PACKETBUF_ATTR_MAC_SEQNO) == BENCH_FRAMES - 1);
+  for(i = 0; i < BENCH_FRAMES; i++) {
+    UNIT_TEST_ASSERT(bench_frame_ok(i));
+  }
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_free, "Free");
+UNIT_TEST(test_free)
+{
+  int numfree;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  numfree = queuebuf_numfree();
+
+  /* The packetbuf keeps the last frame it views until it is cleared */
+  for(i = 0; i < BENCH_FRAMES; i++) {
+    queuebuf_free(frames[i]);
+  }
+  UNIT_TEST_ASSERT(queuebuf_numfree() == numfree + BENCH_FRAMES);
+  UNIT_TEST_ASSERT(packetbuf_datalen() == BENCH_LEN);
+  UNIT_TEST_ASSERT(((uint8_t *)packetbuf_dataptr())[BENCH_LEN - 1] ==
+                   (uint8_t)(BENCH_FRAMES - 1 + BENCH_LEN - 1));
+  packetbuf_clear();
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(bench_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  bench_init();
+
+  UNIT_TEST_RUN(test_queue);
+  UNIT_TEST_RUN(test_copy);
+  UNIT_TEST_RUN(test_view);
+  UNIT_TEST_RUN(test_free);
+
+  bench_done();
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the byte and bulk ring buffer libraries
+ *
+ *         Moves BENCH_BYTES bytes through a 128 byte ring buffer one
+ *         byte at a time with ringbuf and ringbuf16, and in blocks
+ *         with ringbuf16_write()/ringbuf16_read(), prints the time
+ *         spent per byte in rtimer_now_fine() ticks and checks that
+ *         the bytes come out in order.
+ */
+
+#include "contiki.h"
+#include "lib/ringbuf.h"
+#include "lib/ringbuf16.h"
+#include "bench.h"
+
+#define BENCH_SIZE  128
+#define BENCH_BYTES 2048
+#define BENCH_BLOCK 48
+
+PROCESS(bench_process, "ring buffer benchmark");
+AUTOSTART_PROCESSES(&bench_process);
+
+static struct ringbuf rb;
+static struct ringbuf16 rb16;
+static uint8_t rb_data[BENCH_SIZE];
+static uint8_t block[BENCH_BLOCK];
+
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_bytes, "Bytes");
+UNIT_TEST(test_bytes)
+{
+  uint16_t i;
+  uint8_t bad = 0;
+
+  UNIT_TEST_BEGIN();
+
+  ringbuf_init(&rb, rb_data, BENCH_SIZE);
+  bench_begin();
+  for(i = 0; i < BENCH_BYTES; i++) {
+    ringbuf_put(&rb, i);
+    if(ringbuf_get(&rb) != (uint8_t)i) {
+      bad++;
+    }
+  }
+  bench_end("ringbuf put+get", BENCH_BYTES);
+  UNIT_TEST_ASSERT(bad == 0);
+
+  ringbuf16_init(&rb16, rb_data, BENCH_SIZE);
+  bench_begin();
+  for(i = 0; i < BENCH_BYTES; i++) {
+    ringbuf16_put(&rb16, i);
+    if(ringbuf16_get(&rb16) != (uint8_t)i) {
+      bad++;
+    }
+  }
+  bench_end("ringbuf16 put+get", BENCH_BYTES);
+  UNIT_TEST_ASSERT(bad == 0);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_blocks, "Blocks");
+UNIT_TEST(test_blocks)
+{
+  uint16_t in = 0, out = 0;
+  uint16_t i, n;
+  uint8_t bad = 0;
+
+  UNIT_TEST_BEGIN();
+
+  /* Blocks that do not divide the buffer, so that they wrap */
+  ringbuf16_init(&rb16, rb_data, BENCH_SIZE);
+  bench_begin();
+  while(out < BENCH_BYTES) {
+    for(i = 0; i < BENCH_BLOCK; i++) {
+      block[i] = in + i;
+    }
+    in += ringbuf16_write(&rb16, block, BENCH_BLOCK);
+    n = ringbuf16_read(&rb16, block, BENCH_BLOCK / 2);
+    for(i = 0; i < n; i++) {
+      if(block[i] != (uint8_t)(out + i)) {
+        bad++;
+      }
+    }
+    out += n;
+  }
+  bench_end("ringbuf16 write+read", out);
+
+  UNIT_TEST_ASSERT(bad == 0);
+  UNIT_TEST_ASSERT(ringbuf16_elements(&rb16) == (uint16_t)(in - out));
+  UNIT_TEST_ASSERT(ringbuf16_elements(&rb16) <= BENCH_SIZE);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(bench_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  bench_init();
+
+  UNIT_TEST_RUN(test_bytes);
+  UNIT_TEST_RUN(test_blocks);
+
+  bench_done();
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
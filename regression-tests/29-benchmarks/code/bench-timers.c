@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Stress benchmark of the etimer and ctimer libraries
+ *
+ *         Sets BENCH_ETIMERS event timers and BENCH_CTIMERS callback
+ *         timers at once, prints the time spent in the library calls
+ *         in rtimer_now_fine() ticks and checks that every timer that
+ *         was not stopped expires once, in order and not too early.
+ */
+
+#include <stdio.h>
+
+#include "contiki.h"
+#include "sys/ctimer.h"
+#include "lib/random.h"
+#include "bench.h"
+
+#ifndef BENCH_ETIMERS
+#define BENCH_ETIMERS 256
+#endif
+
+#ifndef BENCH_CTIMERS
+#define BENCH_CTIMERS 64
+#endif
+
+#define BENCH_MAX_INTERVAL (10 * CLOCK_SECOND)
+
+PROCESS(bench_process, "etimer and ctimer benchmark");
+AUTOSTART_PROCESSES(&bench_process);
+
+static struct etimer et[BENCH_ETIMERS];
+static struct ctimer ct[BENCH_CTIMERS];
+static uint8_t et_fired[BENCH_ETIMERS];
+static uint8_t ct_fired[BENCH_CTIMERS];
+static uint16_t et_late;
+static uint16_t et_early;
+static uint16_t et_unordered;
+static clock_time_t last_expiration;
+static struct etimer done;
+
+/*---------------------------------------------------------------------------*/
+static void
+ct_callback(void *ptr)
+{
+  ct_fired[(struct ctimer *)ptr - ct]++;
+}
+/*---------------------------------------------------------------------------*/
+static clock_time_t
+soonest(void)
+{
+  clock_time_t now = clock_time();
+  clock_time_t left, min = 0;
+  uint8_t found = 0;
+  int i;
+
+  for(i = 0; i < BENCH_ETIMERS; i++) {
+    if(!etimer_expired(&et[i])) {
+      left = etimer_expiration_time(&et[i]) - now;
+      if(!found || left < min) {
+        min = left;
+        found = 1;
+      }
+    }
+  }
+  return now + min;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_set, "Set");
+UNIT_TEST(test_set)
+{
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  bench_begin();
+  for(i = 0; i < BENCH_ETIMERS; i++) {
+    etimer_set(&et[i], 1 + random_rand() % BENCH_MAX_INTERVAL);
+  }
+  bench_end("etimer_set", BENCH_ETIMERS);
+
+  bench_begin();
+  for(i = 0; i < BENCH_CTIMERS; i++) {
+    ctimer_set(&ct[i], 1 + random_rand() % BENCH_MAX_INTERVAL, ct_callback, &ct[i]);
+  }
+  bench_end("ctimer_set", BENCH_CTIMERS);
+
+  /* Setting a pending timer again must not add it twice */
+  bench_begin();
+  for(i = 0; i < BENCH_ETIMERS; i++) {
+    etimer_restart(&et[i]);
+  }
+  bench_end("etimer_restart", BENCH_ETIMERS);
+
+  UNIT_TEST_ASSERT(etimer_pending());
+  UNIT_TEST_ASSERT(etimer_next_expiration_time() == soonest());
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_next, "Next expiration");
+UNIT_TEST(test_next)
+{
+  clock_time_t next = 0;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  bench_begin();
+  for(i = 0; i < BENCH_ETIMERS; i++) {
+    next = etimer_next_expiration_time();
+  }
+  bench_end("etimer_next_expiration_time", BENCH_ETIMERS);
+
+  UNIT_TEST_ASSERT(next == soonest());
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_stop, "Stop");
+UNIT_TEST(test_stop)
+{
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  /* Every third timer, so that the head of the list is hit too */
+  bench_begin();
+  for(i = 0; i < BENCH_ETIMERS; i += 3) {
+    etimer_stop(&et[i]);
+  }
+  bench_end("etimer_stop", (BENCH_ETIMERS + 2) / 3);
+
+  for(i = 0; i < BENCH_CTIMERS; i += 3) {
+    ctimer_stop(&ct[i]);
+  }
+
+  for(i = 0; i < BENCH_ETIMERS; i += 3) {
+    UNIT_TEST_ASSERT(etimer_expired(&et[i]));
+  }
+  UNIT_TEST_ASSERT(etimer_next_expiration_time() == soonest());
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_expired, "Expired");
+UNIT_TEST(test_expired)
+{
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  for(i = 0; i < BENCH_ETIMERS; i++) {
+    UNIT_TEST_ASSERT(et_fired[i] == (i % 3 == 0 ? 0 : 1));
+  }
+  for(i = 0; i < BENCH_CTIMERS; i++) {
+    UNIT_TEST_ASSERT(ct_fired[i] == (i % 3 == 0 ? 0 : 1));
+  }
+  UNIT_TEST_ASSERT(et_early == 0);
+  UNIT_TEST_ASSERT(et_unordered == 0);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(bench_process, ev, data)
+{
+  static struct etimer *t;
+
+  PROCESS_BEGIN();
+
+  bench_init();
+
+  UNIT_TEST_RUN(test_set);
+  UNIT_TEST_RUN(test_next);
+  UNIT_TEST_RUN(test_stop);
+
+  etimer_set(&done, BENCH_MAX_INTERVAL + CLOCK_SECOND);
+
+  while(1) {
+    PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_TIMER);
+    t = data;
+    if(t == &done) {
+      break;
+    }
+
+    if(clock_time() - etimer_start_time(t) < t->timer.interval) {
+      et_early++;
+    }
+    if(clock_time() - etimer_expiration_time(t) > CLOCK_SECOND / 8) {
+      et_late++;
+    }
+    if((clock_time_t)(etimer_expiration_time(t) - last_expiration) > BENCH_MAX_INTERVAL &&
+       last_expiration != 0) {
+      et_unordered++;
+    }
+    last_expiration = etimer_expiration_time(t);
+    et_fired[t - et]++;
+  }
+
+  printf("bench late %u of %u\n", et_late, BENCH_ETIMERS - (BENCH_ETIMERS + 2) / 3);
+
+  UNIT_TEST_RUN(test_expired);
+
+  bench_done();
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Helpers shared by the benchmarks
+ */
+
+#include <stdio.h>
+
+#include "contiki.h"
+#include "bench.h"
+
+static uint32_t start;
+
+/*---------------------------------------------------------------------------*/
+void
+bench_init(void)
+{
+  printf("Run unit-test\n");
+  printf("---\n");
+  printf("bench ticks per second %lu\n", (unsigned long)RTIMER_HF_SECOND);
+}
+/*---------------------------------------------------------------------------*/
+void
+bench_done(void)
+{
+  printf("=check-me= DONE\n");
+}
+/*---------------------------------------------------------------------------*/
+void
+bench_begin(void)
+{
+  start = rtimer_now_fine();
+}
+/*---------------------------------------------------------------------------*/
+void
+bench_end(const char *what, unsigned n)
+{
+  uint32_t ticks = rtimer_now_fine() - start;
+
+  printf("bench %s n %u ticks %lu per-op %lu\n", what, n,
+         (unsigned long)ticks, (unsigned long)(ticks / n));
+}
+/*---------------------------------------------------------------------------*/
+void
+bench_print_report(const unit_test_t *utp)
+{
+  printf("=check-me= ");
+  if(utp->result == unit_test_failure) {
+    printf("FAILED   - %s: exit at L%u\n", utp->descr, utp->exit_line);
+  } else {
+    printf("SUCCEEDED - %s\n", utp->descr);
+  }
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,10 @@
+#ifndef BENCH_PROJECT_CONF_H_
+#define BENCH_PROJECT_CONF_H_
+
+/* Same clock, rtimer and netstack configuration as examples/c-sync,
+   which is the only one the modified Sky port is built with */
+#include "../../../examples/c-sync/project-conf.h"
+
+#define UNIT_TEST_PRINT_FUNCTION bench_print_report
+
+#endif /* BENCH_PROJECT_CONF_H_ */
@@ -0,0 +1,35 @@
+/* Runs every benchmark at once, one per mote: logs the bench lines and
+   fails on any failed check once all the motes are done */
+TIMEOUT(120000, log.testFailed());
+
+var failed = false;
+var done = {};
+var ndone = 0;
+
+while(ndone < sim.getMotesCount()) {
+    YIELD();
+
+    if(msg.startsWith("bench")) {
+        log.log(time + " node-" + id + " " + msg + "\n");
+        continue;
+    }
+
+    if(msg.contains("=check-me=") == false) {
+        continue;
+    }
+
+    log.log(time + " node-" + id + " " + msg + "\n");
+
+    if(msg.contains("FAILED")) {
+        failed = true;
+    }
+
+    if(msg.contains("DONE") && !done[id]) {
+        done[id] = true;
+        ndone++;
+    }
+}
+if(failed) {
+    log.testFailed();
+}
+log.testOK();
@@ -0,0 +1,806 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/*
+ * csync-log: single pass analysis of C-sync logs.
+ *
+ * Reads Cooja LogListener exports ("<time>\tID:<n>\t<message>", time in
+ * ms or [hh:]mm:ss.mmm), serial logs with a leading timestamp in seconds
+ * (-s), or bare serial output, from any number of files or stdin. Offsets
+ * are converted from rtimer ticks at 524288 per second (Sky, see
+ * RTIMER_CONF_SECOND in examples/c-sync/project-conf.h), -r sets another
+ * rate. Memory use depends on the number of nodes and neighbour pairs
+ * only, so testbed logs of any size are fine.
+ *
+ * Recognised lines, as printed by examples/c-sync and core/net/c-sync:
+ *   "%u -> E_R ..."                   state transitions (csync_print_status)
+ *   "%u %lu N %u fd %ld"              GTSP offset to a neighbour
+ *   ", sync C %u, N %u @ %ld"         consensus synchronization offset
+ *   "%u PB <hex>"                     per-phase record (csync-phase.c)
+ *
+ * Output: a summary on stdout (text, or JSON with -j) and, with
+ * -o prefix, prefix-timeline.csv, prefix-nodes.csv, prefix-pairs.csv,
+ * prefix-phases.csv and prefix.json.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <ctype.h>
+#include <unistd.h>
+#include <err.h>
+
+/* Offsets are printed in rtimer ticks, RTIMER_CONF_SECOND of
+   examples/c-sync on Sky unless -r says otherwise */
+#define DEFAULT_TICKS_PER_SECOND 524288.0
+#define TICKS_TO_US(t) ((t) * 1000000.0 / ticks_per_second)
+
+#define MAX_NODE_ID 65536
+#define LINE_LEN 4096
+
+/* Phases in the order of state_t / 2 */
+#define NUM_PHASES 10
+static const char *phase_names[NUM_PHASES] = {
+  "D", "E_R", "E_D", "C_R", "C_D", "CONV", "CS_R", "CS_S", "I", "BYZ"
+};
+#define PHASE_IDLE 8
+
+/* Per-phase record of csync_phase_dump() */
+#define PB_RECORD_LEN 27
+enum {
+  PB_CPU, PB_LPM, PB_TRANSMIT, PB_LISTEN, PB_TIME,
+  PB_ENTERED, PB_SENT, PB_RECEIVED, PB_FIELDS
+};
+
+/*
+ * Offset histogram: exact below 16 ticks, then 8 sub-buckets per power
+ * of two, i.e. about 12% resolution up to 2^32 ticks.
+ */
+#define HIST_LINEAR 16
+#define HIST_SUB 8
+#define HIST_BUCKETS (HIST_LINEAR + (32 - 4) * HIST_SUB)
+
+struct hist {
+  uint64_t n;
+  uint64_t max;
+  double sum;
+  uint64_t bucket[HIST_BUCKETS];
+};
+
+struct pair {
+  uint32_t key;              /* lower id << 16 | higher id, 0 if free */
+  struct hist h;
+};
+
+struct node {
+  uint16_t id;
+  int phase;                 /* -1 until the first transition */
+  double first_seen;
+  double first_idle;
+  double last_change;
+  unsigned rounds;           /* number of times IDLE was entered */
+  unsigned transitions;
+  unsigned long fd_lines[NUM_PHASES];
+  double phase_time[NUM_PHASES];
+  uint32_t pb[NUM_PHASES][PB_FIELDS];
+  int has_pb;
+};
+
+static struct node *nodes[MAX_NODE_ID];
+static uint16_t node_ids[MAX_NODE_ID];
+static unsigned num_nodes;
+
+static struct pair *pairs;
+static unsigned pairs_size, pairs_used;
+
+static struct hist all_offsets;
+static struct hist cons_offsets;
+
+static double ticks_per_second = DEFAULT_TICKS_PER_SECOND;
+static int timestamps_in_seconds;
+static int include_unsynced;
+static int json_out;
+static FILE *timeline;
+
+static unsigned long lines, parsed_lines;
+static double log_end = -1;
+/*---------------------------------------------------------------------------*/
+static unsigned
+hist_index(uint64_t v)
+{
+  unsigned e;
+
+  if(v < HIST_LINEAR) {
+    return v;
+  }
+  for(e = 4; e < 32 && (v >> (e + 1)) != 0; e++);
+  if(e >= 32) {
+    return HIST_BUCKETS - 1;
+  }
+  return HIST_LINEAR + (e - 4) * HIST_SUB + ((v >> (e - 3)) & (HIST_SUB - 1));
+}
+/*---------------------------------------------------------------------------*/
+/* Upper end of a bucket, so that percentiles never understate */
+static uint64_t
+hist_bound(unsigned i)
+{
+  unsigned e, sub;
+
+  if(i < HIST_LINEAR) {
+    return i;
+  }
+  e = 4 + (i - HIST_LINEAR) / HIST_SUB;
+  sub = (i - HIST_LINEAR) % HIST_SUB;
+  return ((uint64_t)(HIST_SUB + sub + 1) << (e - 3)) - 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+hist_add(struct hist *h, long v)
+{
+  uint64_t a = v < 0 ? -(int64_t)v : v;
+
+  h->n++;
+  h->sum += a;
+  if(a > h->max) {
+    h->max = a;
+  }
+  h->bucket[hist_index(a)]++;
+}
+/*---------------------------------------------------------------------------*/
+static uint64_t
+hist_percentile(const struct hist *h, double p)
+{
+  uint64_t rank, seen = 0;
+  unsigned i;
+
+  if(h->n == 0) {
+    return 0;
+  }
+  rank = (uint64_t)(p / 100.0 * (h->n - 1)) + 1;
+  for(i = 0; i < HIST_BUCKETS; i++) {
+    seen += h->bucket[i];
+    if(seen >= rank) {
+      return hist_bound(i) < h->max ? hist_bound(i) : h->max;
+    }
+  }
+  return h->max;
+}
+/*---------------------------------------------------------------------------*/
+static struct node *
+get_node(unsigned id, double t)
+{
+  struct node *n;
+
+  if(id >= MAX_NODE_ID) {
+    return NULL;
+  }
+  n = nodes[id];
+  if(n == NULL) {
+    n = calloc(1, sizeof(struct node));
+    if(n == NULL) {
+      err(1, "calloc");
+    }
+    n->id = id;
+    n->phase = -1;
+    n->first_seen = t;
+    n->first_idle = -1;
+    n->last_change = t;
+    nodes[id] = n;
+    node_ids[num_nodes++] = id;
+  }
+  return n;
+}
+/*---------------------------------------------------------------------------*/
+static struct pair *
+pair_lookup(uint32_t key)
+{
+  unsigned i = (key * 2654435761u) & (pairs_size - 1);
+
+  while(pairs[i].key != 0 && pairs[i].key != key) {
+    i = (i + 1) & (pairs_size - 1);
+  }
+  return &pairs[i];
+}
+/*---------------------------------------------------------------------------*/
+static struct pair *
+get_pair(unsigned a, unsigned b)
+{
+  struct pair *old, *p;
+  unsigned old_size, i;
+  uint32_t key;
+
+  key = a < b ? (a << 16 | b) : (b << 16 | a);
+  if(key == 0) {
+    key = 1 << 16; /* 0 marks free slots */
+  }
+
+  if(2 * (pairs_used + 1) > pairs_size) {
+    old = pairs;
+    old_size = pairs_size;
+    pairs_size = pairs_size ? 2 * pairs_size : 256;
+    pairs = calloc(pairs_size, sizeof(struct pair));
+    if(pairs == NULL) {
+      err(1, "calloc");
+    }
+    for(i = 0; i < old_size; i++) {
+      if(old[i].key != 0) {
+        *pair_lookup(old[i].key) = old[i];
+      }
+    }
+    free(old);
+  }
+
+  p = pair_lookup(key);
+  if(p->key == 0) {
+    p->key = key;
+    pairs_used++;
+  }
+  return p;
+}
+/*---------------------------------------------------------------------------*/
+static int
+phase_from_name(const char *s)
+{
+  int i;
+  size_t len;
+
+  for(len = 0; s[len] != '\0' && !isspace((unsigned char)s[len]) && s[len] != ','; len++);
+  for(i = 0; i < NUM_PHASES; i++) {
+    if(strlen(phase_names[i]) == len && strncmp(s, phase_names[i], len) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+transition(struct node *n, int phase, double t)
+{
+  if(n->phase >= 0 && t >= 0) {
+    n->phase_time[n->phase] += t - n->last_change;
+  }
+  if(timeline != NULL) {
+    fprintf(timeline, "%u,%.3f,%s,%s\n", n->id, t,
+            n->phase >= 0 ? phase_names[n->phase] : "", phase_names[phase]);
+  }
+  n->phase = phase;
+  n->last_change = t;
+  n->transitions++;
+  if(phase == PHASE_IDLE) {
+    n->rounds++;
+    if(n->first_idle < 0) {
+      n->first_idle = t;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static int
+hexval(char c)
+{
+  if(c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if(c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if(c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+/*---------------------------------------------------------------------------*/
+/* The records are cumulative, the last one of a node wins */
+static void
+phase_record(struct node *n, const char *hex)
+{
+  uint8_t rec[PB_RECORD_LEN];
+  unsigned i, f, off;
+  int hi, lo;
+
+  for(;;) {
+    for(i = 0; i < PB_RECORD_LEN; i++) {
+      if((hi = hexval(hex[2 * i])) < 0 || (lo = hexval(hex[2 * i + 1])) < 0) {
+        return;
+      }
+      rec[i] = hi << 4 | lo;
+    }
+    hex += 2 * PB_RECORD_LEN;
+    if(rec[0] >= NUM_PHASES) {
+      continue;
+    }
+    off = 1;
+    for(f = 0; f < PB_FIELDS; f++) {
+      if(f < PB_ENTERED) {
+        n->pb[rec[0]][f] = rec[off] | rec[off + 1] << 8 |
+          (uint32_t)rec[off + 2] << 16 | (uint32_t)rec[off + 3] << 24;
+        off += 4;
+      } else {
+        n->pb[rec[0]][f] = rec[off] | rec[off + 1] << 8;
+        off += 2;
+      }
+    }
+    n->has_pb = 1;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+offset_sample(struct node *n, unsigned neighbour, long offset, struct hist *h)
+{
+  if(!include_unsynced && n->first_idle < 0) {
+    return;
+  }
+  hist_add(&get_pair(n->id, neighbour)->h, offset);
+  hist_add(h, offset);
+}
+/*---------------------------------------------------------------------------*/
+static double
+parse_time(const char *s)
+{
+  double v = 0, b;
+  char *end;
+
+  /* ms, or [hh:]mm:ss.mmm */
+  b = strtod(s, &end);
+  if(*end != ':') {
+    return b;
+  }
+  while(*end == ':') {
+    v = v * 60 + b;
+    b = strtod(end + 1, &end);
+  }
+  return (v * 60 + b) * 1000;
+}
+/*---------------------------------------------------------------------------*/
+static void
+parse_line(char *line)
+{
+  char *msg, *p, *end;
+  double t = -1;
+  long id = -1;
+  unsigned long u1, u2;
+  long l;
+  int phase;
+  struct node *n;
+
+  lines++;
+  msg = line;
+
+  if((p = strstr(line, "ID:")) != NULL) {
+    /* Cooja */
+    t = parse_time(line);
+    id = strtol(p + 3, &msg, 10);
+    while(*msg == '\t' || *msg == ' ') {
+      msg++;
+    }
+  } else if(timestamps_in_seconds) {
+    t = strtod(line, &msg) * 1000;
+    while(*msg == '\t' || *msg == ' ') {
+      msg++;
+    }
+  }
+
+  /* Every C-sync line starts with the node id */
+  u1 = strtoul(msg, &end, 10);
+  if(end == msg) {
+    if(id < 0 || strstr(msg, "sync C ") == NULL) {
+      return;
+    }
+  } else {
+    if(id < 0) {
+      id = u1;
+    }
+    msg = end;
+  }
+
+  n = get_node(id, t);
+  if(n == NULL) {
+    return;
+  }
+  if(t > log_end) {
+    log_end = t;
+  }
+  while(*msg == ' ') {
+    msg++;
+  }
+
+  if(msg[0] == '-' && msg[1] == '>' && msg[2] == ' ') {
+    if((phase = phase_from_name(msg + 3)) >= 0) {
+      transition(n, phase, t);
+      parsed_lines++;
+    }
+  } else if(msg[0] == 'P' && msg[1] == 'B' && msg[2] == ' ') {
+    phase_record(n, msg + 3);
+    parsed_lines++;
+  } else if(sscanf(msg, "%lu N %lu fd %ld", &u1, &u2, &l) == 3) {
+    offset_sample(n, u2, l, &all_offsets);
+    if(n->phase >= 0) {
+      n->fd_lines[n->phase]++;
+    }
+    parsed_lines++;
+  }
+
+  if((p = strstr(msg, "sync C ")) != NULL &&
+     sscanf(p, "sync C %lu, N %lu @ %ld", &u1, &u2, &l) == 3) {
+    offset_sample(n, u2, l, &cons_offsets);
+    if(p == msg) {
+      parsed_lines++;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+parse_file(FILE *f)
+{
+  char line[LINE_LEN];
+  size_t len;
+  int c;
+
+  while(fgets(line, sizeof(line), f) != NULL) {
+    len = strlen(line);
+    if(len > 0 && line[len - 1] != '\n' && !feof(f)) {
+      /* Overlong line, drop the rest */
+      while((c = getc(f)) != EOF && c != '\n');
+    }
+    parse_line(line);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static int
+cmp_id(const void *a, const void *b)
+{
+  return *(const uint16_t *)a - *(const uint16_t *)b;
+}
+/*---------------------------------------------------------------------------*/
+static FILE *
+open_out(const char *prefix, const char *suffix)
+{
+  char name[1024];
+  FILE *f;
+
+  snprintf(name, sizeof(name), "%s%s", prefix, suffix);
+  f = fopen(name, "w");
+  if(f == NULL) {
+    err(1, "%s", name);
+  }
+  return f;
+}
+/*---------------------------------------------------------------------------*/
+static void
+write_nodes_csv(FILE *f)
+{
+  struct node *n;
+  unsigned i;
+
+  fprintf(f, "node,first_seen_ms,first_idle_ms,time_to_sync_ms,rounds,transitions\n");
+  for(i = 0; i < num_nodes; i++) {
+    n = nodes[node_ids[i]];
+    fprintf(f, "%u,%.3f,%.3f,%.3f,%u,%u\n", n->id, n->first_seen,
+            n->first_idle, n->first_idle >= 0 ? n->first_idle - n->first_seen : -1,
+            n->rounds, n->transitions);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+write_pairs_csv(FILE *f)
+{
+  unsigned i;
+  struct hist *h;
+
+  fprintf(f, "a,b,samples,mean_us,p50_us,p90_us,p99_us,max_us\n");
+  for(i = 0; i < pairs_size; i++) {
+    if(pairs[i].key == 0) {
+      continue;
+    }
+    h = &pairs[i].h;
+    fprintf(f, "%u,%u,%llu,%.1f,%.1f,%.1f,%.1f,%.1f\n",
+            pairs[i].key >> 16, pairs[i].key & 0xffff,
+            (unsigned long long)h->n, TICKS_TO_US(h->sum / h->n),
+            TICKS_TO_US((double)hist_percentile(h, 50)),
+            TICKS_TO_US((double)hist_percentile(h, 90)),
+            TICKS_TO_US((double)hist_percentile(h, 99)),
+            TICKS_TO_US((double)h->max));
+  }
+}
+/*---------------------------------------------------------------------------*/
+struct phase_total {
+  double time_ms;
+  unsigned long fd_lines;
+  uint64_t pb[PB_FIELDS];
+};
+
+/* The phase a node is in when the log ends counts up to the last line */
+static void
+close_phases(void)
+{
+  struct node *n;
+  unsigned i;
+
+  for(i = 0; i < num_nodes; i++) {
+    n = nodes[node_ids[i]];
+    if(n->phase >= 0 && n->last_change >= 0 && log_end > n->last_change) {
+      n->phase_time[n->phase] += log_end - n->last_change;
+      n->last_change = log_end;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+phase_totals(struct phase_total *tot)
+{
+  struct node *n;
+  unsigned i, p, f;
+
+  memset(tot, 0, NUM_PHASES * sizeof(struct phase_total));
+  for(i = 0; i < num_nodes; i++) {
+    n = nodes[node_ids[i]];
+    for(p = 0; p < NUM_PHASES; p++) {
+      tot[p].time_ms += n->phase_time[p];
+      tot[p].fd_lines += n->fd_lines[p];
+      for(f = 0; f < PB_FIELDS; f++) {
+        tot[p].pb[f] += n->pb[p][f];
+      }
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+write_phases_csv(FILE *f, const struct phase_total *tot)
+{
+  unsigned p;
+
+  fprintf(f, "phase,time_ms,fd_lines,entered,beacons_sent,beacons_received,cpu,lpm,transmit,listen\n");
+  for(p = 0; p < NUM_PHASES; p++) {
+    fprintf(f, "%s,%.3f,%lu,%llu,%llu,%llu,%llu,%llu,%llu,%llu\n",
+            phase_names[p], tot[p].time_ms, tot[p].fd_lines,
+            (unsigned long long)tot[p].pb[PB_ENTERED],
+            (unsigned long long)tot[p].pb[PB_SENT],
+            (unsigned long long)tot[p].pb[PB_RECEIVED],
+            (unsigned long long)tot[p].pb[PB_CPU],
+            (unsigned long long)tot[p].pb[PB_LPM],
+            (unsigned long long)tot[p].pb[PB_TRANSMIT],
+            (unsigned long long)tot[p].pb[PB_LISTEN]);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+json_hist(FILE *f, const char *name, const struct hist *h)
+{
+  fprintf(f, "  \"%s\": {\"samples\": %llu, \"mean_us\": %.1f, \"p50_us\": %.1f, "
+          "\"p90_us\": %.1f, \"p99_us\": %.1f, \"max_us\": %.1f},\n", name,
+          (unsigned long long)h->n, h->n ? TICKS_TO_US(h->sum / h->n) : 0.0,
+          TICKS_TO_US((double)hist_percentile(h, 50)),
+          TICKS_TO_US((double)hist_percentile(h, 90)),
+          TICKS_TO_US((double)hist_percentile(h, 99)),
+          TICKS_TO_US((double)h->max));
+}
+/*---------------------------------------------------------------------------*/
+static void
+sync_times(unsigned *synced, double *max_tts, double *all_idle)
+{
+  struct node *n;
+  unsigned i;
+
+  *synced = 0;
+  *max_tts = -1;
+  *all_idle = -1;
+  for(i = 0; i < num_nodes; i++) {
+    n = nodes[node_ids[i]];
+    if(n->first_idle < 0) {
+      continue;
+    }
+    (*synced)++;
+    if(n->first_idle - n->first_seen > *max_tts) {
+      *max_tts = n->first_idle - n->first_seen;
+    }
+    if(n->first_idle > *all_idle) {
+      *all_idle = n->first_idle;
+    }
+  }
+  if(*synced < num_nodes) {
+    *all_idle = -1;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+write_json(FILE *f, const struct phase_total *tot)
+{
+  unsigned synced, p;
+  double max_tts, all_idle;
+
+  sync_times(&synced, &max_tts, &all_idle);
+
+  fprintf(f, "{\n");
+  fprintf(f, "  \"lines\": %lu,\n  \"parsed\": %lu,\n", lines, parsed_lines);
+  fprintf(f, "  \"nodes\": %u,\n  \"synced_nodes\": %u,\n", num_nodes, synced);
+  fprintf(f, "  \"max_time_to_sync_ms\": %.3f,\n", max_tts);
+  fprintf(f, "  \"all_idle_ms\": %.3f,\n", all_idle);
+  fprintf(f, "  \"pairs\": %u,\n", pairs_used);
+  json_hist(f, "gtsp_offset", &all_offsets);
+  json_hist(f, "consensus_offset", &cons_offsets);
+  fprintf(f, "  \"phases\": [\n");
+  for(p = 0; p < NUM_PHASES; p++) {
+    fprintf(f, "    {\"phase\": \"%s\", \"time_ms\": %.3f, \"fd_lines\": %lu, "
+            "\"entered\": %llu, \"beacons_sent\": %llu, \"beacons_received\": %llu, "
+            "\"cpu\": %llu, \"transmit\": %llu, \"listen\": %llu}%s\n",
+            phase_names[p], tot[p].time_ms, tot[p].fd_lines,
+            (unsigned long long)tot[p].pb[PB_ENTERED],
+            (unsigned long long)tot[p].pb[PB_SENT],
+            (unsigned long long)tot[p].pb[PB_RECEIVED],
+            (unsigned long long)tot[p].pb[PB_CPU],
+            (unsigned long long)tot[p].pb[PB_TRANSMIT],
+            (unsigned long long)tot[p].pb[PB_LISTEN],
+            p + 1 < NUM_PHASES ? "," : "");
+  }
+  fprintf(f, "  ]\n}\n");
+}
+/*---------------------------------------------------------------------------*/
+static void
+write_text(FILE *f, const struct phase_total *tot)
+{
+  struct hist pairs_max;
+  unsigned synced, p, i;
+  double max_tts, all_idle;
+
+  sync_times(&synced, &max_tts, &all_idle);
+
+  /* Distribution of the worst offset of each pair */
+  memset(&pairs_max, 0, sizeof(pairs_max));
+  for(i = 0; i < pairs_size; i++) {
+    if(pairs[i].key != 0) {
+      hist_add(&pairs_max, pairs[i].h.max);
+    }
+  }
+
+  fprintf(f, "%lu lines, %lu parsed, %u nodes, %u reached IDLE\n",
+          lines, parsed_lines, num_nodes, synced);
+  fprintf(f, "time to sync: max %.1f ms, all IDLE at %.1f ms\n", max_tts, all_idle);
+  fprintf(f, "gtsp offset us: n %llu p50 %.1f p90 %.1f p99 %.1f max %.1f\n",
+          (unsigned long long)all_offsets.n,
+          TICKS_TO_US((double)hist_percentile(&all_offsets, 50)),
+          TICKS_TO_US((double)hist_percentile(&all_offsets, 90)),
+          TICKS_TO_US((double)hist_percentile(&all_offsets, 99)),
+          TICKS_TO_US((double)all_offsets.max));
+  fprintf(f, "consensus offset us: n %llu p50 %.1f p99 %.1f max %.1f\n",
+          (unsigned long long)cons_offsets.n,
+          TICKS_TO_US((double)hist_percentile(&cons_offsets, 50)),
+          TICKS_TO_US((double)hist_percentile(&cons_offsets, 99)),
+          TICKS_TO_US((double)cons_offsets.max));
+  fprintf(f, "worst pair offset us over %u pairs: p50 %.1f p90 %.1f max %.1f\n",
+          pairs_used,
+          TICKS_TO_US((double)hist_percentile(&pairs_max, 50)),
+          TICKS_TO_US((double)hist_percentile(&pairs_max, 90)),
+          TICKS_TO_US((double)pairs_max.max));
+  fprintf(f, "%-5s %12s %9s %8s %8s %8s\n", "phase", "time_ms", "fd", "entered", "sent", "recv");
+  for(p = 0; p < NUM_PHASES; p++) {
+    fprintf(f, "%-5s %12.1f %9lu %8llu %8llu %8llu\n", phase_names[p],
+            tot[p].time_ms, tot[p].fd_lines,
+            (unsigned long long)tot[p].pb[PB_ENTERED],
+            (unsigned long long)tot[p].pb[PB_SENT],
+            (unsigned long long)tot[p].pb[PB_RECEIVED]);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+usage(void)
+{
+  fprintf(stderr, "usage: csync-log [-s] [-a] [-j] [-r ticks] [-o prefix] [file ...]\n"
+          "  -s  lines start with a timestamp in seconds (serial logs)\n"
+          "  -a  also count offsets of nodes that never reached IDLE\n"
+          "  -j  JSON summary on stdout\n"
+          "  -r  rtimer ticks per second of the offsets (default %.0f)\n"
+          "  -o  write prefix-{timeline,nodes,pairs,phases}.csv and prefix.json\n",
+          DEFAULT_TICKS_PER_SECOND);
+  exit(1);
+}
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char **argv)
+{
+  struct phase_total tot[NUM_PHASES];
+  const char *prefix = NULL;
+  FILE *f;
+  int c, i;
+
+  while((c = getopt(argc, argv, "sajr:o:h")) != -1) {
+    switch(c) {
+    case 's':
+      timestamps_in_seconds = 1;
+      break;
+    case 'a':
+      include_unsynced = 1;
+      break;
+    case 'j':
+      json_out = 1;
+      break;
+    case 'r':
+      ticks_per_second = atof(optarg);
+      if(ticks_per_second <= 0) {
+        usage();
+      }
+      break;
+    case 'o':
+      prefix = optarg;
+      break;
+    default:
+      usage();
+    }
+  }
+
+  if(prefix != NULL) {
+    timeline = open_out(prefix, "-timeline.csv");
+    fprintf(timeline, "node,time_ms,from,to\n");
+  }
+
+  if(optind == argc) {
+    parse_file(stdin);
+  }
+  for(i = optind; i < argc; i++) {
+    if(strcmp(argv[i], "-") == 0) {
+      parse_file(stdin);
+      continue;
+    }
+    f = fopen(argv[i], "r");
+    if(f == NULL) {
+      err(1, "%s", argv[i]);
+    }
+    parse_file(f);
+    fclose(f);
+  }
+
+  qsort(node_ids, num_nodes, sizeof(uint16_t), cmp_id);
+  close_phases();
+  phase_totals(tot);
+
+  if(prefix != NULL) {
+    fclose(timeline);
+    f = open_out(prefix, "-nodes.csv");
+    write_nodes_csv(f);
+    fclose(f);
+    f = open_out(prefix, "-pairs.csv");
+    write_pairs_csv(f);
+    fclose(f);
+    f = open_out(prefix, "-phases.csv");
+    write_phases_csv(f, tot);
+    fclose(f);
+    f = open_out(prefix, ".json");
+    write_json(f, tot);
+    fclose(f);
+  }
+
+  if(json_out) {
+    write_json(stdout, tot);
+  } else {
+    write_text(stdout, tot);
+  }
+  return 0;
+}